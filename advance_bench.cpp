@@ -0,0 +1,179 @@
+#include "sim_advance.h"
+#include "autopilot.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+
+// Tua nhanh headless bằng simAdvanceRules() so với gọi simStepRules() từng tick, lần lượt với mọi SIM_VARIANT_RULES.
+// replay: phát lại dòng thời gian nhảy đã ghi của autopilot, mỗi đoạn giữa 2 cú nhảy chạy 1 lần.
+// random: autopilot có nhiễu, mỗi quyết định giữ 1..24 tick, để phủ các ca chạm trần, chạm đất, chạm ống.
+// skip: simSkipRules() dừng ở từng sự kiện, so với bước từng tick tới sự kiện đầu tiên.
+// Trạng thái và cờ sự kiện của mỗi đoạn phải giống hệt bước từng tick.
+const int DEFAULT_GAMES = 200;
+const int MAX_TICKS = 36000;            // 10 phút chơi ở 60 Hz
+const int RANDOM_GAMES = 20000;
+
+static bool sameState(const SimState& a, const SimState& b) {
+    if (a.birdY != b.birdY || a.birdVelocity != b.birdVelocity || a.pipeCount != b.pipeCount || a.score != b.score ||
+        a.gameOver != b.gameOver || a.rng != b.rng || a.tick != b.tick)
+        return false;
+    for (int i = 0; i < a.pipeCount; i++) {
+        if (a.pipes[i].x != b.pipes[i].x || a.pipes[i].height != b.pipes[i].height || a.pipes[i].scored != b.pipes[i].scored ||
+            a.pipes[i].gap != b.pipes[i].gap)
+            return false;
+    }
+    return true;
+}
+
+static int fineAdvance(const SimRules& r, SimState& s, bool jump, int ticks) {
+    int events = 0;
+    for (int i = 0; i < ticks && !s.gameOver; i++) events |= simStepRules(r, s, jump && i == 0);
+    return events;
+}
+
+struct Timeline {
+    uint32_t seed;
+    vector<int> segments;       // số tick từ mỗi cú nhảy tới cú sau; đoạn đầu không nhảy
+};
+
+// Bước từng tick, dừng sau tick đầu tiên có sự kiện; giống simSkipRules()
+static int fineSkip(const SimRules& r, SimState& s, int ticks) {
+    for (int i = 0; i < ticks && !s.gameOver; i++) {
+        if (int events = simStepRules(r, s, false)) return events;
+    }
+    return 0;
+}
+
+// Đoạn giữa 2 cú nhảy bằng simSkipRules(): tick nhảy chạy simStepRules(), phần còn lại tua từ sự kiện này sang sự kiện kế
+static void skipAdvance(const SimRules& r, SimState& s, bool jump, int ticks) {
+    if (ticks == 0) return;
+    simStepRules(r, s, jump);
+    for (int left = ticks - 1; left > 0 && !s.gameOver;) {
+        uint32_t start = s.tick;
+        simSkipRules(r, s, left);
+        left -= (int)(s.tick - start);
+    }
+}
+
+enum ReplayMode { REPLAY_FINE, REPLAY_SWEPT, REPLAY_SKIP };
+
+static long long replay(const SimRules& r, const vector<Timeline>& timelines, ReplayMode mode) {
+    long long ticks = 0;
+    for (const Timeline& timeline : timelines) {
+        SimState s;
+        simSeed(s, timeline.seed);
+        for (size_t i = 0; i < timeline.segments.size(); i++) {
+            if (mode == REPLAY_SWEPT) simAdvanceRules(r, s, i > 0, timeline.segments[i]);
+            else if (mode == REPLAY_SKIP) skipAdvance(r, s, i > 0, timeline.segments[i]);
+            else fineAdvance(r, s, i > 0, timeline.segments[i]);
+        }
+        ticks += s.tick;
+    }
+    return ticks;
+}
+
+int main(int argc, char* argv[]) {
+    int games = argc > 1 ? atoi(argv[1]) : DEFAULT_GAMES;
+    if (games <= 0) games = DEFAULT_GAMES;
+
+    long long totalMismatches = 0;
+    for (int variant = 0; variant < SIM_VARIANT_COUNT; variant++) {
+        const SimRules& r = SIM_VARIANT_RULES[variant];
+        printf("== %s\n", simVariantName((SimVariant)variant));
+
+        // ghi dòng thời gian nhảy của autopilot
+        vector<Timeline> timelines(games);
+        long long jumps = 0, recorded = 0;
+        for (int game = 0; game < games; game++) {
+            Timeline& timeline = timelines[game];
+            timeline.seed = 5000 + game;
+            timeline.segments.push_back(0);
+            SimState s;
+            simSeed(s, timeline.seed);
+            while (!s.gameOver && (int)s.tick < MAX_TICKS) {
+                bool jump = autopilotDecideRules(r, s);
+                if (jump) timeline.segments.push_back(0);
+                timeline.segments.back()++;
+                simStepRules(r, s, jump);
+            }
+            jumps += timeline.segments.size() - 1;
+            recorded += s.tick;
+        }
+
+        long long mismatches = 0;
+        for (const Timeline& timeline : timelines) {
+            SimState a, b, c;
+            simSeed(a, timeline.seed);
+            simSeed(b, timeline.seed);
+            simSeed(c, timeline.seed);
+            for (size_t i = 0; i < timeline.segments.size(); i++) {
+                mismatches += simAdvanceRules(r, a, i > 0, timeline.segments[i]) != fineAdvance(r, b, i > 0, timeline.segments[i]) ||
+                              !sameState(a, b);
+                skipAdvance(r, c, i > 0, timeline.segments[i]);
+                mismatches += !sameState(c, b);
+            }
+        }
+        printf("replay: %d autopilot games, %.1f ticks/jump, %lld mismatched segments\n", games, (double)recorded / max(1LL, jumps),
+               mismatches);
+        const char* names[] = {"fine", "swept", "skip"};
+        double fineS = 0;
+        for (ReplayMode mode : {REPLAY_FINE, REPLAY_SWEPT, REPLAY_SKIP}) {
+            auto start = chrono::steady_clock::now();
+            long long ticks = replay(r, timelines, mode);
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            if (mode == REPLAY_FINE) fineS = seconds;
+            printf("  %-6s %8.1f Mticks/s %6.1fx\n", names[mode], ticks / seconds / 1e6, fineS / seconds);
+        }
+        totalMismatches += mismatches;
+
+        // quyết định nhiễu, đoạn giữ ngẫu nhiên: chỉ kiểm tra giống hệt
+        uint32_t rng = 31337;
+        long long segments = 0, deaths[3] = {0, 0, 0};
+        mismatches = 0;
+        for (int game = 0; game < RANDOM_GAMES; game++) {
+            SimState a, b;
+            simSeed(a, game + 1);
+            b = a;
+            while (!a.gameOver && (int)a.tick < MAX_TICKS) {
+                bool jump = autopilotDecideRules(r, a) != (simRandom(rng) % 6 == 0);
+                int hold = 1 + (int)(simRandom(rng) % 24);
+                int events = simAdvanceRules(r, a, jump, hold);
+                mismatches += events != fineAdvance(r, b, jump, hold) || !sameState(a, b);
+                segments++;
+                if (events & SIM_HIT_CEILING) deaths[0]++;
+                if (events & SIM_HIT_GROUND) deaths[1]++;
+                if (events & SIM_HIT_PIPE) deaths[2]++;
+                a = b;
+            }
+        }
+        printf("random: %d games, %lld segments (%lld with ceiling hits, %lld ground, %lld pipe), %lld mismatched\n", RANDOM_GAMES,
+               segments, deaths[0], deaths[1], deaths[2], mismatches);
+        totalMismatches += mismatches;
+
+        // tua không nhảy tới sự kiện kế tiếp từ các trạng thái ngẫu nhiên
+        long long calls = 0, stops = 0, skipped = 0;
+        mismatches = 0;
+        for (int game = 0; game < RANDOM_GAMES; game++) {
+            SimState s;
+            simSeed(s, game + 1);
+            while (!s.gameOver && (int)s.tick < MAX_TICKS) {
+                simStepRules(r, s, autopilotDecideRules(r, s) != (simRandom(rng) % 6 == 0));
+                if (simRandom(rng) % 8) continue;
+                SimState a = s, b = s;
+                int limit = 1 + (int)(simRandom(rng) % 200);
+                int events = simSkipRules(r, a, limit);
+                mismatches += events != fineSkip(r, b, limit) || !sameState(a, b);
+                calls++;
+                stops += events != 0;
+                skipped += a.tick - s.tick;
+            }
+        }
+        printf("skip: %lld calls, %lld stopped at an event, %.1f ticks per call, %lld mismatched\n", calls, stops,
+               (double)skipped / max(1LL, calls), mismatches);
+        totalMismatches += mismatches;
+    }
+    return totalMismatches != 0;
+}
@@ -0,0 +1,56 @@
+#include "alloc_tracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+using namespace std;
+
+static atomic<Uint64> allocations{0};
+
+static void* countedMalloc(size_t size) {
+    allocations.fetch_add(1, memory_order_relaxed);
+    return malloc(size);
+}
+
+static void* countedCalloc(size_t count, size_t size) {
+    allocations.fetch_add(1, memory_order_relaxed);
+    return calloc(count, size);
+}
+
+static void* countedRealloc(void* ptr, size_t size) {
+    allocations.fetch_add(1, memory_order_relaxed);
+    return realloc(ptr, size);
+}
+
+void installSdlAllocHooks() {
+    SDL_SetMemoryFunctions(countedMalloc, countedCalloc, countedRealloc, free);
+}
+
+Uint64 allocationCount() {
+    return allocations.load(memory_order_relaxed);
+}
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+    allocations.fetch_add(1, memory_order_relaxed);
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept {
+    return operator new(size, nothrow);
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+void operator delete(void* p, const nothrow_t&) noexcept { free(p); }
+void operator delete[](void* p, const nothrow_t&) noexcept { free(p); }
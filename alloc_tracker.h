@@ -0,0 +1,10 @@
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include <SDL2/SDL.h>
+
+// Đếm số lần cấp phát heap (operator new + SDL_malloc) để đo trên HUD
+void installSdlAllocHooks();    // gọi trước SDL_Init
+Uint64 allocationCount();
+
+#endif
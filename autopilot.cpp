@@ -0,0 +1,102 @@
+#include "autopilot.h"
+
+const int AUTOPILOT_MARGIN = 4;         // px chừa lại phía trên đáy khe
+const int HIT_TOP = COLLISION_OFFSET;
+const int HIT_BOTTOM = BIRD_SIZE - COLLISION_OFFSET;
+const int HIT_LEFT = BIRD_X + COLLISION_OFFSET;
+const int HIT_RIGHT = BIRD_X + BIRD_SIZE - COLLISION_OFFSET;
+
+static int freeFallY(const SimRules& r, int y, int velocity, int k) {
+    return y + k * velocity + r.gravity * k * (k + 1) / 2;
+}
+
+static int predictYRules(const SimRules& r, int y, int velocity, int k) {
+    if (velocity + r.gravity >= 0) return freeFallY(r, y, velocity, k);// đang rơi thì không thể chạm trần
+
+    // tick cao nhất là khi vận tốc hết âm
+    int peak = (-velocity + r.gravity - 1) / r.gravity;
+    if (freeFallY(r, y, velocity, peak) >= 0) return freeFallY(r, y, velocity, k);
+
+    // tìm tick đầu tiên vượt trần, sau đó chim rơi lại từ (0, 0)
+    int lo = 1, hi = peak;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (freeFallY(r, y, velocity, mid) < 0) hi = mid;
+        else lo = mid + 1;
+    }
+    if (k < lo) return freeFallY(r, y, velocity, k);
+    return freeFallY(r, 0, 0, k - lo);
+}
+
+static bool pipeOverlapWindowRules(const SimRules& r, const Pipe& pipe, int& enter, int& exit) {
+    // sau k tick ống ở x - k*pipeSpeed; chồng khi x_k < HIT_RIGHT và x_k + pipeWidth > HIT_LEFT
+    int a = pipe.x - HIT_RIGHT;
+    int b = pipe.x + r.pipeWidth - HIT_LEFT;
+    enter = a < 0 ? 1 : a / r.pipeSpeed + 1;
+    exit = b <= 0 ? 0 : (b + r.pipeSpeed - 1) / r.pipeSpeed - 1;
+    return exit >= enter;
+}
+
+int predictY(int y, int velocity, int k) {
+    return predictYRules(CLASSIC_RULES, y, velocity, k);
+}
+
+bool pipeOverlapWindow(const Pipe& pipe, int& enter, int& exit) {
+    return pipeOverlapWindowRules(CLASSIC_RULES, pipe, enter, exit);
+}
+
+// Điểm cao nhất của cung nhảy trong [lo, hi]; cung giảm rồi tăng nên chỉ cần kẹp đỉnh vào khoảng
+static int arcMinY(const SimRules& r, int y, int lo, int hi) {
+    int peak = -r.jumpStrength / r.gravity;
+    int k = peak < lo ? lo : peak > hi ? hi : peak;
+    return predictYRules(r, y, r.jumpStrength, k);
+}
+
+bool autopilotDecideRules(const SimRules& r, const SimState& s) {
+    int y1 = predictYRules(r, s.birdY, s.birdVelocity, 1);
+    int bottomLimit = r.groundY() - BIRD_SIZE + HIT_BOTTOM;
+    bool hardFail = y1 + BIRD_SIZE >= r.groundY();
+
+    bool nextFound = false;
+    for (int i = 0; i < s.pipeCount; i++) {
+        const Pipe& pipe = s.pipes[i];
+        int enter, exit;
+        if (!pipeOverlapWindowRules(r, pipe, enter, exit)) continue;
+
+        int gapBottom = pipe.height + pipe.gap;
+        if (!nextFound) {
+            bottomLimit = gapBottom;// bám theo đáy khe của ống kế tiếp ngay cả khi chưa tới
+            nextFound = true;
+        }
+        if (enter <= 1 && y1 + HIT_BOTTOM > gapBottom) hardFail = true;
+    }
+
+    bool needJump = y1 + HIT_BOTTOM > bottomLimit - AUTOPILOT_MARGIN;
+    if (!needJump) return false;
+    if (hardFail) return true;
+
+    // chỉ khi định nhảy mới xét cung nhảy, tới khi chim rơi lại qua độ cao hiện tại
+    for (int i = 0; i < s.pipeCount; i++) {
+        const Pipe& pipe = s.pipes[i];
+        int enter, exit;
+        if (!pipeOverlapWindowRules(r, pipe, enter, exit)) continue;
+        if (enter <= 2 * (-r.jumpStrength / r.gravity) + 1 && arcMinY(r, s.birdY, enter, exit) + HIT_TOP < pipe.height) return false;
+    }
+    return true;
+}
+
+bool autopilotDecide(const SimState& s) {
+    return autopilotDecideRules(CLASSIC_RULES, s);
+}
+
+bool gapCenterDecide(const SimState& s) {
+    if (s.birdVelocity < 0) return false;
+    int target = SCREEN_HEIGHT / 2;
+    for (int i = 0; i < s.pipeCount; i++) {
+        if (s.pipes[i].x + PIPE_WIDTH >= BIRD_X) {
+            target = s.pipes[i].height + s.pipes[i].gap / 2;
+            break;
+        }
+    }
+    return s.birdY + BIRD_SIZE / 2 > target;
+}
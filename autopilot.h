@@ -0,0 +1,21 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include "sim.h"
+
+// Vị trí chim sau k tick không nhảy, dạng đóng, có tính cả việc bị chặn ở trần y = 0
+int predictY(int y, int velocity, int k);
+
+// Khoảng tick [enter, exit] mà hitbox chim chồng lên ống theo phương ngang, tính từ tick kế tiếp là 1
+bool pipeOverlapWindow(const Pipe& pipe, int& enter, int& exit);
+
+// Bot giải tích: chỉ nhảy khi không nhảy thì tick sau sẽ xuống dưới đáy khe của ống kế tiếp,
+// và cung nhảy không đụng ống trên. O(số ống), không rẽ nhánh theo số tick.
+bool autopilotDecide(const SimState& s);
+// Như trên cho luật bất kỳ (công cụ quét tham số); autopilotDecide() = luật gốc
+bool autopilotDecideRules(const SimRules& r, const SimState& s);
+
+// Bot đơn giản để so sánh: nhảy khi đang rơi và ở dưới tâm khe ống kế tiếp
+bool gapCenterDecide(const SimState& s);
+
+#endif
@@ -0,0 +1,111 @@
+#include "autopilot.h"
+#include "dp_table.h"
+#include "nn_policy.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+
+// So sánh các bot: tỉ lệ sống tới MAX_TICKS, điểm trung bình, và chi phí 1 lần quyết định
+const int DEFAULT_GAMES = 1000;
+const int MAX_TICKS = 36000;            // 10 phút chơi ở 60 Hz
+const int SAMPLE_STATES = 1 << 20;
+
+typedef bool (*Policy)(const SimState&);
+
+static bool neverJump(const SimState&) {
+    return false;
+}
+
+static NnModel neuralModel;
+
+static bool neuralPolicy(const SimState& s) {
+    return nnDecide(neuralModel, s);
+}
+
+// Tra bảng của dp_solve; đầu ván khi ống đầu còn xa thì dùng autopilot
+static bool dpPolicy(const SimState& s) {
+    bool jump;
+    if (dpDecide(s, jump)) return jump;
+    return autopilotDecide(s);
+}
+
+struct PolicyResult {
+    int survived = 0;
+    double meanScore = 0;
+    double meanTicks = 0;
+    double nsPerDecision = 0;
+};
+
+static PolicyResult runPolicy(Policy policy, int games, vector<SimState>& samples) {
+    PolicyResult result;
+    long long totalScore = 0, totalTicks = 0;
+    for (int game = 0; game < games; game++) {
+        SimState s;
+        simSeed(s, 1000 + game);// cùng seed cho mọi bot
+        while (!s.gameOver && (int)s.tick < MAX_TICKS) {
+            if ((int)samples.size() < SAMPLE_STATES) samples.push_back(s);
+            simStep(s, policy(s));
+        }
+        if (!s.gameOver) result.survived++;
+        totalScore += s.score;
+        totalTicks += s.tick;
+    }
+    result.meanScore = (double)totalScore / games;
+    result.meanTicks = (double)totalTicks / games;
+    return result;
+}
+
+// Đo riêng hàm quyết định trên các trạng thái đã ghi lại, không lẫn chi phí simStep
+static double timeDecisions(Policy policy, const vector<SimState>& samples) {
+    const int REPEAT = 8;
+    int jumps = 0;
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < REPEAT; r++) {
+        for (const SimState& s : samples) jumps += policy(s);
+    }
+    auto elapsed = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    if (jumps < 0) printf("%d", jumps);// giữ kết quả để compiler không bỏ vòng lặp
+    return elapsed / ((double)samples.size() * REPEAT);
+}
+
+int main(int argc, char* argv[]) {
+    int games = argc > 1 ? atoi(argv[1]) : DEFAULT_GAMES;
+    if (games <= 0) games = DEFAULT_GAMES;
+    const char* tablePath = argc > 2 ? argv[2] : "dp_table.bin";
+    bool haveTable = loadDpTable(tablePath);
+    const char* policyPath = argc > 3 ? argv[3] : "policy.nn";
+    bool havePolicy = loadNnModel(neuralModel, policyPath);
+
+    struct {
+        const char* name;
+        Policy policy;
+    } policies[] = {
+        {"autopilot", autopilotDecide},
+        {"gap-center", gapCenterDecide},
+        {"never-jump", neverJump},
+        {"dp-table", dpPolicy},
+        {"neural", neuralPolicy},
+    };
+
+    printf("%d games per policy, survival = alive after %d ticks\n", games, MAX_TICKS);
+    printf("%-12s %10s %12s %12s %14s\n", "policy", "survival", "mean score", "mean ticks", "ns/decision");
+    for (auto& p : policies) {
+        if (p.policy == dpPolicy && !haveTable) {
+            printf("%-12s (no %s, run dp_solve first)\n", p.name, tablePath);
+            continue;
+        }
+        if (p.policy == neuralPolicy && !havePolicy) {
+            printf("%-12s (no %s, run evolve first)\n", p.name, policyPath);
+            continue;
+        }
+        vector<SimState> samples;
+        samples.reserve(SAMPLE_STATES);
+        PolicyResult result = runPolicy(p.policy, games, samples);
+        result.nsPerDecision = timeDecisions(p.policy, samples);
+        printf("%-12s %9.1f%% %12.1f %12.0f %14.2f\n", p.name, 100.0 * result.survived / games,
+               result.meanScore, result.meanTicks, result.nsPerDecision);
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "broad_phase.h"
+#include <algorithm>
+using namespace std;
+
+void initBroadPhase(BroadPhase& broad, int capacity) {
+    broad.order.resize(capacity);
+    broad.candidates = 0;
+}
+
+static int bucketOf(int y) {
+    return min(max(y / BROAD_BUCKET_SIZE, 0), BROAD_BUCKETS - 1);
+}
+
+// phép thử chính xác, giống fixedHitsPipe() cho 1 ống
+static bool hitsPipe(const Pipe& pipe, Fixed y) {
+    return y + toFixed(COLLISION_OFFSET) < toFixed(pipe.height) || y + toFixed(BIRD_SIZE - COLLISION_OFFSET) > toFixed(pipe.height + pipe.gap);
+}
+
+int collideBirds(BroadPhase& broad, const SimState& course, const Fixed* y, int count, uint8_t* hit) {
+    const int hitLeft = BIRD_X + COLLISION_OFFSET;
+    const int hitRight = BIRD_X + BIRD_SIZE - COLLISION_OFFSET;
+
+    // quét x: ống xếp tăng dần theo x, qua khỏi hitRight thì dừng
+    const Pipe* active[MAX_PIPES];
+    int activeCount = 0;
+    for (int i = 0; i < course.pipeCount; i++) {
+        const Pipe& pipe = course.pipes[i];
+        if (pipe.x >= hitRight) break;
+        if (pipe.x + PIPE_WIDTH > hitLeft) active[activeCount++] = &pipe;
+    }
+    if (activeCount == 0) return 0;// phần lớn tick: không đụng tới chim nào
+
+    int hits = 0;
+    if (count < BROAD_MIN_BIRDS) {
+        // ít chim thì sắp bucket đắt hơn thử thẳng
+        for (int a = 0; a < activeCount; a++) {
+            for (int i = 0; i < count; i++) {
+                if (hit[i] || !hitsPipe(*active[a], y[i])) continue;
+                hit[i] = 1;
+                hits++;
+            }
+        }
+        broad.candidates += (long long)activeCount * count;
+        return hits;
+    }
+
+    // sắp chim theo bucket y bằng đếm (O(n), không cần giữ thứ tự giữa các tick)
+    int* start = broad.start;
+    fill(start, start + BROAD_BUCKETS + 1, 0);
+    for (int i = 0; i < count; i++) start[bucketOf(fixedFloor(y[i])) + 1]++;
+    for (int b = 0; b < BROAD_BUCKETS; b++) start[b + 1] += start[b];
+    int next[BROAD_BUCKETS];
+    copy(start, start + BROAD_BUCKETS, next);
+    for (int i = 0; i < count; i++) broad.order[next[bucketOf(fixedFloor(y[i]))]++] = i;
+
+    for (int a = 0; a < activeCount; a++) {
+        const Pipe& pipe = *active[a];
+        // bucket trên cùng còn có thể chạm ống trên, bucket dưới cùng còn có thể chạm ống dưới
+        int topLast = bucketOf(pipe.height - COLLISION_OFFSET - 1);
+        int bottomFirst = bucketOf(pipe.height + pipe.gap - BIRD_SIZE + COLLISION_OFFSET);// y lẻ pixel ở đúng mốc vẫn chạm
+        int ranges[2][2] = {{0, start[topLast + 1]}, {start[bottomFirst], count}};
+        for (auto& range : ranges) {
+            for (int k = range[0]; k < range[1]; k++) {
+                int i = broad.order[k];
+                if (hit[i] || !hitsPipe(pipe, y[i])) continue;
+                hit[i] = 1;
+                hits++;
+            }
+            broad.candidates += range[1] - range[0];
+        }
+    }
+    return hits;
+}
@@ -0,0 +1,27 @@
+#ifndef BROAD_PHASE_H
+#define BROAD_PHASE_H
+
+#include "fixed.h"
+#include <cstdint>
+#include <vector>
+
+// Pha rộng cho va chạm nhiều chim x nhiều ống.
+// Ống đã xếp theo x (sinh theo thứ tự, cùng tốc độ) nên quét x chỉ giữ ống đè lên cột hitbox chim;
+// chim xếp theo bucket y, mỗi ống chỉ cần lấy các bucket nằm ngoài khe hở.
+// Cặp ứng viên (chim ở bucket biên) mới tới phép thử hình chữ nhật chính xác.
+const int BROAD_BUCKET_SIZE = 8;
+const int BROAD_BUCKETS = SCREEN_HEIGHT / BROAD_BUCKET_SIZE;
+const int BROAD_MIN_BIRDS = 64;         // ít hơn thì bỏ bucket, thử thẳng với ống đã qua quét x
+
+struct BroadPhase {
+    std::vector<int> order;             // chỉ số chim xếp theo bucket y
+    int start[BROAD_BUCKETS + 1];
+    long long candidates = 0;           // cộng dồn số cặp đã thử chính xác
+};
+
+void initBroadPhase(BroadPhase& broad, int capacity);
+// Đặt hit[i] = 1 cho chim i (hitbox ở độ cao y[i] lẻ pixel, cột BIRD_X) chạm ống; không xoá hit[] của chim còn lại.
+// Trả về số chim mới bị đánh dấu.
+int collideBirds(BroadPhase& broad, const SimState& course, const Fixed* y, int count, uint8_t* hit);
+
+#endif
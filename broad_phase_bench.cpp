@@ -0,0 +1,76 @@
+#include "broad_phase.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+
+// Đo va chạm chim-ống từ 1 tới 100k chim: duyệt mọi cặp (fixedHitsPipe từng chim) so với pha rộng.
+// Chim bám theo tâm khe của ống sắp tới cộng độ lệch cố định mỗi chim, giống 1 đàn đang bay.
+const int TICKS = 1200;
+const int SPREAD = 120;         // độ lệch tối đa quanh tâm khe
+
+int main(int argc, char* argv[]) {
+    int maxBirds = argc > 1 ? atoi(argv[1]) : 100000;
+    if (maxBirds <= 0) maxBirds = 100000;
+
+    // đường ống dùng chung, bước trước để cả 2 cách đo cùng dữ liệu
+    vector<SimState> courses(TICKS);
+    SimState course;
+    simSeed(course, 12345);
+    for (int t = 0; t < TICKS; t++) {
+        simStepPipes(course);
+        courses[t] = course;
+    }
+
+    printf("%d ticks per size\n", TICKS);
+    printf("%8s %14s %14s %9s %14s %8s\n", "birds", "naive ns/bird", "broad ns/bird", "speedup", "pairs/bird", "agree");
+    for (int birds = 1; birds <= maxBirds; birds *= 10) {
+        vector<Fixed> offset(birds);// lẻ pixel như chim của chế độ đàn
+        uint32_t rng = 777;
+        for (Fixed& o : offset) o = (Fixed)(simRandom(rng) % (2 * toFixed(SPREAD) + 1)) - toFixed(SPREAD);
+        vector<Fixed> y(birds * TICKS);
+        for (int t = 0; t < TICKS; t++) {
+            const SimState& s = courses[t];
+            int center = SCREEN_HEIGHT / 2;
+            for (int i = 0; i < s.pipeCount; i++) {
+                if (s.pipes[i].x + PIPE_WIDTH >= BIRD_X) {
+                    center = s.pipes[i].height + s.pipes[i].gap / 2 - BIRD_SIZE / 2;
+                    break;
+                }
+            }
+            for (int i = 0; i < birds; i++) y[t * birds + i] = clamp(toFixed(center) + offset[i], 0, FX_GROUND_Y);
+        }
+
+        vector<uint8_t> naiveHit(birds), broadHit(birds);
+        long long naiveCount = 0, broadCount = 0, disagree = 0;
+        auto start = chrono::steady_clock::now();
+        for (int t = 0; t < TICKS; t++) {
+            const Fixed* ty = &y[t * birds];
+            for (int i = 0; i < birds; i++) naiveCount += naiveHit[i] = fixedHitsPipe(courses[t], ty[i]);
+        }
+        double naiveNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+
+        BroadPhase broad;
+        initBroadPhase(broad, birds);
+        start = chrono::steady_clock::now();
+        for (int t = 0; t < TICKS; t++) {
+            fill(broadHit.begin(), broadHit.end(), 0);
+            broadCount += collideBirds(broad, courses[t], &y[t * birds], birds, broadHit.data());
+        }
+        double broadNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        for (int t = 0; t < TICKS; t++) {
+            const Fixed* ty = &y[t * birds];
+            fill(broadHit.begin(), broadHit.end(), 0);
+            collideBirds(broad, courses[t], ty, birds, broadHit.data());
+            for (int i = 0; i < birds; i++) disagree += broadHit[i] != (uint8_t)fixedHitsPipe(courses[t], ty[i]);
+        }
+        broad.candidates /= 2;// đã chạy 2 lượt
+
+        double perBird = (double)birds * TICKS;
+        printf("%8d %14.2f %14.2f %8.1fx %14.3f %8s\n", birds, naiveNs / perBird, broadNs / perBird, naiveNs / broadNs,
+               broad.candidates / perBird, disagree == 0 && naiveCount == broadCount ? "yes" : "NO");
+    }
+    return 0;
+}
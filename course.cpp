@@ -0,0 +1,121 @@
+#include "course.h"
+#include "autopilot.h"
+#include <algorithm>
+using namespace std;
+
+CourseKey courseAt(const CourseCurve& curve, int pipe) {
+    CourseKey key = curve.keys[curve.keyCount - 1];
+    for (int i = 1; i < curve.keyCount; i++) {
+        const CourseKey& a = curve.keys[i - 1];
+        const CourseKey& b = curve.keys[i];
+        if (pipe >= b.pipe) continue;
+        if (pipe <= a.pipe) {
+            key = a;
+            break;
+        }
+        int t = pipe - a.pipe, span = b.pipe - a.pipe;
+        key = {pipe, a.gap + (b.gap - a.gap) * t / span, a.spacing + (b.spacing - a.spacing) * t / span,
+               a.maxDelta + (b.maxDelta - a.maxDelta) * t / span, a.speed + (b.speed - a.speed) * t / span};
+        break;
+    }
+    key.gap = clamp(key.gap, COURSE_MIN_GAP, COURSE_MAX_GAP);
+    key.spacing = clamp(key.spacing, COURSE_MIN_SPACING, SCREEN_WIDTH);
+    key.maxDelta = max(key.maxDelta, 0);
+    key.speed = max(key.speed, 1);
+    return key;
+}
+
+// Luật lúc chim đang hướng tới ống thứ s.score: tốc độ của ống đó, còn khe nằm trong từng Pipe
+static SimRules courseRules(const CourseCurve& curve, const SimState& s) {
+    SimRules r = CLASSIC_RULES;
+    r.pipeSpeed = courseAt(curve, s.score).speed;
+    return r;
+}
+
+// 1 tick như simStepRules(), nhưng ống mới lấy từ spawn (nullptr = không còn ống để sinh)
+static int courseTick(const CourseCurve& curve, SimState& s, bool jump, const CoursePipe* spawn) {
+    SimRules r = courseRules(curve, s);
+    int events = simStepBirdRules(r, s.birdY, s.birdVelocity, jump);
+    simShiftPipesRules(r, s);
+    if (spawn && s.pipeCount < MAX_PIPES && (s.pipeCount == 0 || s.pipes[s.pipeCount - 1].x < SCREEN_WIDTH - spawn->spacing)) {
+        s.pipes[s.pipeCount++] = {SCREEN_WIDTH, spawn->height, false, spawn->gap};
+        events |= SIM_PIPE_SPAWNED;
+    }
+    events |= simScorePipesRules(r, s);
+    if (simHitsPipeRules(r, s, s.birdY)) events |= SIM_HIT_PIPE;
+    if (events & (SIM_HIT_GROUND | SIM_HIT_PIPE)) s.gameOver = true;
+    s.tick++;
+    return events;
+}
+
+// Bot tham chiếu chỉ nhìn ống đang hướng tới. Ống sau chưa chạm được chim trước khi qua ống này
+// (COURSE_MIN_SPACING), nên đường bay kiểm chứng khi ống sau chưa tồn tại vẫn y nguyên khi nó xuất hiện.
+bool courseDecide(const CourseStream& c, const SimState& s) {
+    SimState view = s;
+    view.pipeCount = 0;
+    for (int i = 0; i < s.pipeCount; i++) {
+        if (!s.pipes[i].scored) {
+            view.pipes[view.pipeCount++] = s.pipes[i];
+            break;
+        }
+    }
+    return autopilotDecideRules(courseRules(c.curve, s), view);
+}
+
+// Chạy bot tham chiếu tới khi ống thứ generated xuất hiện rồi qua được nó; lần sau dễ hơn lần trước
+static void produce(CourseStream& c) {
+    CourseKey key = courseAt(c.curve, c.generated);
+    int offset = key.maxDelta ? (int)(simRandom(c.rng) % (2 * key.maxDelta + 1)) - key.maxDelta : 0;
+    CoursePipe pipe = {};
+    SimState spawned;
+    bool cleared = false;
+    for (int attempt = 0; attempt <= COURSE_RETRIES && !cleared; attempt++) {
+        int gap = min(key.gap + attempt * 10, COURSE_MAX_GAP);
+        int maxHeight = PIPE_MIN_HEIGHT + SCREEN_HEIGHT - GROUND_HEIGHT - gap - 200 - 1;
+        pipe.height = (int16_t)clamp(c.lastHeight + offset * (COURSE_RETRIES - attempt) / COURSE_RETRIES, PIPE_MIN_HEIGHT, maxHeight);
+        pipe.gap = (int16_t)gap;
+        pipe.spacing = (int16_t)min(key.spacing + attempt * 20, SCREEN_WIDTH);
+        pipe.retries = (int16_t)attempt;
+
+        spawned = c.witness;
+        while (!spawned.gameOver && !(courseTick(c.curve, spawned, courseDecide(c, spawned), &pipe) & SIM_PIPE_SPAWNED)) {}
+        SimState s = spawned;
+        while (!s.gameOver && s.score <= (int)c.generated) courseTick(c.curve, s, courseDecide(c, s), nullptr);
+        cleared = !s.gameOver;
+    }
+    if (pipe.retries > 0) c.softened++;
+    if (!cleared) c.unverified++;
+    c.witness = spawned;
+    c.lastHeight = pipe.height;
+    c.generated++;
+    c.ring[(c.head + c.count) % COURSE_LOOKAHEAD] = pipe;
+    c.count++;
+}
+
+void initCourse(CourseStream& c, uint32_t seed, const CourseCurve& curve) {
+    c.curve = curve;
+    c.rng = seed;
+    c.generated = 0;
+    c.lastHeight = PIPE_MIN_HEIGHT + (SCREEN_HEIGHT - GROUND_HEIGHT - courseAt(curve, 0).gap - 200) / 2;
+    c.witness = SimState();
+    c.head = 0;
+    c.count = 0;
+    c.softened = 0;
+    c.unverified = 0;
+    while (c.count < COURSE_LOOKAHEAD) produce(c);
+}
+
+const CoursePipe& coursePeek(CourseStream& c, int ahead) {
+    while (c.count <= ahead) produce(c);
+    return c.ring[(c.head + ahead) % COURSE_LOOKAHEAD];
+}
+
+int courseStep(CourseStream& c, SimState& s, bool jump) {
+    int events = courseTick(c.curve, s, jump, &coursePeek(c, 0));
+    if (events & SIM_PIPE_SPAWNED) {
+        c.head = (c.head + 1) % COURSE_LOOKAHEAD;
+        c.count--;
+        produce(c);// giữ đủ COURSE_LOOKAHEAD ống phía trước, mỗi ống xuất hiện sinh thêm đúng 1 ống
+    }
+    return events;
+}
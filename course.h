@@ -0,0 +1,74 @@
+#ifndef COURSE_H
+#define COURSE_H
+
+#include "sim.h"
+#include <cstdint>
+
+// Đường ống sinh dần từ seed + đường cong độ khó theo số thứ tự ống (khe, khoảng cách, độ lệch chiều cao, tốc độ).
+// Một bot tham chiếu (witness) chạy trước chim vài ống: ống nào nó không qua được thì sinh lại dễ hơn,
+// nên mọi đoạn đã sinh đều có ít nhất 1 đường bay qua. Bộ nhớ cố định, mỗi ống tốn O(1).
+const int COURSE_MAX_KEYS = 8;
+const int COURSE_LOOKAHEAD = 8;         // số ống sinh sẵn trước khi chim cần
+const int COURSE_RETRIES = 4;           // lần sinh lại, lần cuối là ống bằng chiều cao ống trước
+const int COURSE_MIN_GAP = 100;
+const int COURSE_MAX_GAP = SCREEN_HEIGHT - GROUND_HEIGHT - 200 - 1;// khung dọc như luật gốc: pipeHeightRange() > 0
+const int COURSE_MIN_SPACING = 160;     // ống sau không chạm được hitbox trước khi qua ống trước, và <= MAX_PIPES ống
+
+// Mốc của đường cong, nội suy tuyến tính giữa các mốc theo số thứ tự ống; sau mốc cuối giữ nguyên (chơi vô tận)
+struct CourseKey {
+    int pipe;
+    int gap;
+    int spacing;            // px giữa 2 ống liên tiếp
+    int maxDelta;           // chênh chiều cao tối đa so với ống trước
+    int speed;              // px/tick khi chim đang hướng tới ống này
+};
+
+struct CourseCurve {
+    int keyCount;
+    CourseKey keys[COURSE_MAX_KEYS];
+};
+
+constexpr CourseCurve COURSE_DEFAULT_CURVE = {5, {
+    {0, 240, 360, 40, 3},
+    {15, 210, 320, 120, 3},
+    {40, 190, 290, 180, 4},
+    {80, 170, 260, 240, 4},
+    {150, 150, 240, 300, 5},
+}};
+
+struct CoursePipe {
+    int16_t height;
+    int16_t gap;
+    int16_t spacing;
+    int16_t retries;        // số lần phải làm dễ đi mới qua được
+};
+
+struct CourseStream {
+    CourseCurve curve;
+    uint32_t rng = 1;
+    uint32_t generated = 0; // số ống đã sinh
+    int lastHeight = 0;
+    SimState witness;       // bot tham chiếu, dừng ngay sau khi ống sinh cuối cùng xuất hiện
+    CoursePipe ring[COURSE_LOOKAHEAD];
+    int head = 0, count = 0;
+    uint32_t softened = 0;  // số ống phải sinh lại
+    uint32_t unverified = 0;// số ống cả lần dễ nhất bot cũng không qua (phải luôn là 0)
+};
+
+CourseKey courseAt(const CourseCurve& curve, int pipe);
+
+// Ván mới; sinh sẵn COURSE_LOOKAHEAD ống. Không cấp phát.
+void initCourse(CourseStream& c, uint32_t seed, const CourseCurve& curve = COURSE_DEFAULT_CURVE);
+
+// Ống thứ ahead trong hàng chờ chưa xuất hiện, ahead < COURSE_LOOKAHEAD
+const CoursePipe& coursePeek(CourseStream& c, int ahead);
+
+// Thay cho simStep() khi chơi đường ống sinh dần; s phải bắt đầu từ SimState() cùng lúc với initCourse().
+// Luôn dùng hitbox chữ nhật như bot tham chiếu: bot quyết định theo hitbox này, kiểm chứng bằng phép thử khác
+// (chim to hơn hitbox) thì nó chết và ống không còn được bảo đảm qua được.
+int courseStep(CourseStream& c, SimState& s, bool jump);
+
+// Quyết định của bot tham chiếu; bắt đầu cùng lúc với ván thì đi đúng đường đã kiểm chứng
+bool courseDecide(const CourseStream& c, const SimState& s);
+
+#endif
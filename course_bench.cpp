@@ -0,0 +1,42 @@
+#include "course.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+using namespace std;
+
+// Chơi đường ống sinh dần bằng bot tham chiếu tới PIPES ống: bot phải không bao giờ chết,
+// đo thời gian sinh mỗi ống (gồm cả kiểm chứng) và tỉ lệ ống phải làm dễ đi.
+int main(int argc, char* argv[]) {
+    int games = argc > 1 ? atoi(argv[1]) : 50;
+    int pipes = argc > 2 ? atoi(argv[2]) : 300;
+    if (games <= 0 || pipes <= 0) {
+        printf("usage: course_bench [games] [pipes per game]\n");
+        return 1;
+    }
+
+    int deaths = 0;
+    long long softened = 0, unverified = 0, generated = 0, ticks = 0;
+    double stepNs = 0;
+    for (int g = 0; g < games; g++) {
+        CourseStream course;
+        SimState s;
+        auto start = chrono::steady_clock::now();
+        initCourse(course, 1000u + g);
+        while (!s.gameOver && s.score < pipes) courseStep(course, s, courseDecide(course, s));
+        stepNs += chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        deaths += s.gameOver;
+        softened += course.softened;
+        unverified += course.unverified;
+        generated += course.generated;
+        ticks += s.tick;
+    }
+
+    printf("%d games x %d pipes, stream %zu bytes, look-ahead %d pipes\n", games, pipes, sizeof(CourseStream), COURSE_LOOKAHEAD);
+    printf("reference deaths %d, unverified pipes %lld, softened %.1f%%\n", deaths, unverified, 100.0 * softened / generated);
+    printf("%.2f us per generated pipe (incl. play), %.0f ns per tick\n", stepNs / generated / 1e3, stepNs / ticks);
+    for (int k = 0; k < COURSE_DEFAULT_CURVE.keyCount; k++) {
+        CourseKey key = COURSE_DEFAULT_CURVE.keys[k];
+        printf("  pipe %4d: gap %d, spacing %d, delta %d, speed %d\n", key.pipe, key.gap, key.spacing, key.maxDelta, key.speed);
+    }
+    return deaths == 0 && unverified == 0 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+#include "dp_table.h"
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Giải bảng sống sót bằng lặp điểm bất động lớn nhất:
+// W(y, v) = trạng thái sống được ngay khi ống mới thành ống hiện tại, với MỌI chiều cao khe.
+// Bắt đầu W = tất cả, mỗi vòng tính lại bảng từ d nhỏ lên d lớn (mỗi h 1 thread), rồi
+// W = AND theo h của cột d = DP_D_MAX. W chỉ giảm nên dừng khi không đổi.
+
+static vector<uint64_t> table(DP_TABLE_WORDS);
+static vector<uint64_t> entry(DP_V_COUNT * DP_Y_WORDS);   // W
+
+static bool successorAlive(int h, int di, int y, int v, bool jump) {
+    if (!dpStepBird(y, v, jump)) return false;
+    int d = DP_D_MIN + (di - 1) * PIPE_SPEED;// sau khi ống dịch
+    if (dpHitsPipe(y, d, h + PIPE_MIN_HEIGHT)) return false;
+    if (di == 0) return dpBit(&entry[(v - DP_V_MIN) * DP_Y_WORDS], y);
+    return dpBit(&table[dpRow(h, di - 1, v - DP_V_MIN)], y);
+}
+
+static void solveSlab(int h) {
+    for (int di = 0; di < DP_D_COUNT; di++) {
+        for (int vi = 0; vi < DP_V_COUNT; vi++) {
+            uint64_t* row = &table[dpRow(h, di, vi)];
+            for (int w = 0; w < DP_Y_WORDS; w++) row[w] = 0;
+            for (int y = 0; y < DP_Y_COUNT; y++) {
+                int v = DP_V_MIN + vi;
+                if (successorAlive(h, di, y, v, false) || successorAlive(h, di, y, v, true))
+                    row[y >> 6] |= 1ull << (y & 63);
+            }
+        }
+    }
+}
+
+static void solvePass(int threadCount) {
+    atomic<int> nextSlab{0};
+    vector<thread> workers;
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&] {
+            for (int h = nextSlab++; h < DP_H_COUNT; h = nextSlab++) solveSlab(h);
+        });
+    }
+    for (auto& worker : workers) worker.join();
+}
+
+// W mới từ cột d = DP_D_MAX; trả về true nếu có thay đổi
+static bool updateEntry() {
+    bool changed = false;
+    for (int vi = 0; vi < DP_V_COUNT; vi++) {
+        for (int w = 0; w < DP_Y_WORDS; w++) {
+            uint64_t bits = entry[vi * DP_Y_WORDS + w];
+            for (int h = 0; h < DP_H_COUNT; h++) bits &= table[dpRow(h, DP_D_COUNT - 1, vi) + w];
+            changed |= bits != entry[vi * DP_Y_WORDS + w];
+            entry[vi * DP_Y_WORDS + w] = bits;
+        }
+    }
+    return changed;
+}
+
+static long long countBits(const vector<uint64_t>& words) {
+    long long count = 0;
+    for (uint64_t w : words) count += popcount(w);
+    return count;
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = argc > 1 ? argv[1] : "dp_table.bin";
+    int threadCount = argc > 2 ? atoi(argv[2]) : (int)thread::hardware_concurrency();
+    if (threadCount <= 0) threadCount = 1;
+
+    for (int vi = 0; vi < DP_V_COUNT; vi++)
+        for (int y = 0; y < DP_Y_COUNT; y++) entry[vi * DP_Y_WORDS + (y >> 6)] |= 1ull << (y & 63);
+
+    auto start = chrono::steady_clock::now();
+    int passes = 0;
+    do {
+        solvePass(threadCount);
+        passes++;
+    } while (updateEntry());
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    long long states = (long long)DP_ROW_COUNT * DP_Y_COUNT;
+    long long alive = countBits(table);
+    printf("%d passes, %d threads, %.2f s\n", passes, threadCount, seconds);
+    printf("%lld/%lld states survivable (%.1f%%), %lld/%d entry states safe for every gap\n",
+           alive, states, 100.0 * alive / states, countBits(entry), DP_V_COUNT * DP_Y_COUNT);
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        printf("cannot write %s\n", path);
+        return 1;
+    }
+    DpHeader header = dpExpectedHeader();
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+              && fwrite(table.data(), sizeof(uint64_t), table.size(), file) == table.size();
+    ok &= fclose(file) == 0;
+    if (!ok) {
+        printf("write failed: %s\n", path);
+        return 1;
+    }
+    printf("wrote %s (%zu bytes)\n", path, sizeof(header) + table.size() * sizeof(uint64_t));
+    return 0;
+}
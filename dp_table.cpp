@@ -0,0 +1,78 @@
+#include "dp_table.h"
+#include "mapped_file.h"
+#include <cstring>
+
+static MappedFile tableFile;
+static const uint64_t* table = nullptr;
+
+DpHeader dpExpectedHeader() {
+    DpHeader header = {};
+    memcpy(header.magic, "FLDP", 4);
+    header.version = 1;
+    header.gravity = GRAVITY;
+    header.jumpStrength = JUMP_STRENGTH;
+    header.pipeGap = PIPE_GAP;
+    header.pipeSpeed = PIPE_SPEED;
+    header.pipeWidth = PIPE_WIDTH;
+    header.birdSize = BIRD_SIZE;
+    header.collisionOffset = COLLISION_OFFSET;
+    header.yCount = DP_Y_COUNT;
+    header.vMin = DP_V_MIN;
+    header.vCount = DP_V_COUNT;
+    header.dMin = DP_D_MIN;
+    header.dCount = DP_D_COUNT;
+    header.hCount = DP_H_COUNT;
+    return header;
+}
+
+bool loadDpTable(const char* path) {
+    unloadDpTable();
+    if (!mapFile(tableFile, path)) return false;
+
+    DpHeader expected = dpExpectedHeader();
+    if (tableFile.size != sizeof(DpHeader) + (size_t)DP_TABLE_WORDS * sizeof(uint64_t)
+        || memcmp(tableFile.data, &expected, sizeof(DpHeader)) != 0) {
+        unmapFile(tableFile);
+        return false;
+    }
+    table = (const uint64_t*)(tableFile.data + sizeof(DpHeader));
+    return true;
+}
+
+void unloadDpTable() {
+    table = nullptr;
+    unmapFile(tableFile);
+}
+
+bool dpTableLoaded() {
+    return table != nullptr;
+}
+
+bool dpSurvivable(int y, int v, int d, int gapTop) {
+    int h = gapTop - PIPE_MIN_HEIGHT;
+    if (!table || y < 0 || y >= DP_Y_COUNT || v < DP_V_MIN || v > DP_V_MAX || h < 0 || h >= DP_H_COUNT) return false;
+    if (d < DP_D_MIN || d > DP_D_MAX || (d - DP_D_MIN) % PIPE_SPEED != 0) return false;
+    return dpBit(table + dpRow(h, (d - DP_D_MIN) / PIPE_SPEED, v - DP_V_MIN), y);
+}
+
+// Tick kế tiếp khi không nhảy còn nằm trong vùng sống không; qua ống thì dùng ống sau thật
+static bool noJumpSurvives(const SimState& s, int current) {
+    int y = s.birdY, v = s.birdVelocity;
+    if (!dpStepBird(y, v, false)) return false;
+    const Pipe& pipe = s.pipes[current];
+    int d = pipe.x - PIPE_SPEED - BIRD_X;
+    if (dpHitsPipe(y, d, pipe.height)) return false;
+    if (d > DP_D_CLEAR) return dpSurvivable(y, v, d, pipe.height);
+    if (current + 1 >= s.pipeCount) return false;
+    const Pipe& next = s.pipes[current + 1];
+    return dpSurvivable(y, v, next.x - PIPE_SPEED - BIRD_X, next.height);
+}
+
+bool dpDecide(const SimState& s, bool& jump) {
+    if (!table) return false;
+    int current = 0;
+    while (current < s.pipeCount && s.pipes[current].x - BIRD_X <= DP_D_CLEAR) current++;
+    if (current == s.pipeCount || s.pipes[current].x - BIRD_X > DP_D_MAX) return false;
+    jump = !noJumpSurvives(s, current);
+    return true;
+}
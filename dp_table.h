@@ -0,0 +1,77 @@
+#ifndef DP_TABLE_H
+#define DP_TABLE_H
+
+#include "sim.h"
+#include <cstdint>
+
+// Bảng sống sót chính xác theo (y, vận tốc, khoảng cách tới ống hiện tại, chiều cao khe).
+// 1 bit/trạng thái: 1 = có cách bay qua ống này và mọi ống sau, dù ống sau cao bao nhiêu.
+// Hành động không lưu: nhảy khi và chỉ khi không nhảy thì trạng thái kế tiếp mất bit sống.
+
+// d = pipe.x - BIRD_X. Hitbox chồng lên ống khi DP_D_CLEAR < d < DP_D_NEAR
+const int DP_D_NEAR = BIRD_SIZE - COLLISION_OFFSET;
+const int DP_D_CLEAR = COLLISION_OFFSET - PIPE_WIDTH;
+// khoảng cách giữa 2 ống: ống cuối phải qua PIPE_SPAWN_X mới sinh ống mới
+const int DP_PIPE_SPACING = ((SCREEN_WIDTH - PIPE_SPAWN_X) / PIPE_SPEED + 1) * PIPE_SPEED;
+// d chỉ nhận các giá trị SCREEN_WIDTH - BIRD_X - k*PIPE_SPEED; bảng phủ 1 chu kỳ ống
+const int DP_D_MIN = DP_D_CLEAR + 1 + (SCREEN_WIDTH - BIRD_X - DP_D_CLEAR - 1) % PIPE_SPEED;
+const int DP_D_MAX = DP_D_MIN - PIPE_SPEED + DP_PIPE_SPACING;
+const int DP_D_COUNT = (DP_D_MAX - DP_D_MIN) / PIPE_SPEED + 1;
+
+const int DP_Y_COUNT = SCREEN_HEIGHT - GROUND_HEIGHT - BIRD_SIZE;  // y còn sống: 0..429
+const int DP_Y_WORDS = (DP_Y_COUNT + 63) / 64;
+const int DP_V_MIN = JUMP_STRENGTH + GRAVITY;
+const int DP_V_MAX = 28;        // rơi tự do từ trần xuống đất không nhanh hơn
+const int DP_V_COUNT = DP_V_MAX - DP_V_MIN + 1;
+const int DP_H_COUNT = PIPE_HEIGHT_RANGE;
+
+const int DP_ROW_COUNT = DP_H_COUNT * DP_D_COUNT * DP_V_COUNT;
+const int DP_TABLE_WORDS = DP_ROW_COUNT * DP_Y_WORDS;
+
+struct DpHeader {
+    char magic[4];          // "FLDP"
+    uint16_t version;
+    int16_t gravity, jumpStrength, pipeGap, pipeSpeed, pipeWidth, birdSize, collisionOffset;
+    int16_t yCount, vMin, vCount, dMin, dCount, hCount;
+};
+static_assert(sizeof(DpHeader) == 32, "dữ liệu bảng phải bắt đầu ở offset chia hết cho 8");
+
+DpHeader dpExpectedHeader();
+
+// Hàng 64-bit theo y của (h, d, v); h = pipe.height - PIPE_MIN_HEIGHT
+inline int dpRow(int h, int di, int vi) {
+    return ((h * DP_D_COUNT + di) * DP_V_COUNT + vi) * DP_Y_WORDS;
+}
+
+inline bool dpBit(const uint64_t* row, int y) {
+    return (row[y >> 6] >> (y & 63)) & 1;
+}
+
+// 1 tick của chim giống simStep(); false nếu chạm đất hoặc vận tốc ra ngoài bảng
+inline bool dpStepBird(int& y, int& v, bool jump) {
+    v = (jump ? JUMP_STRENGTH : v) + GRAVITY;
+    y += v;
+    if (y < 0) {
+        y = 0;
+        v = 0;
+    }
+    return y < DP_Y_COUNT && v <= DP_V_MAX;
+}
+
+// d là khoảng cách sau khi ống đã dịch trong tick này
+inline bool dpHitsPipe(int y, int d, int height) {
+    if (d <= DP_D_CLEAR || d >= DP_D_NEAR) return false;
+    return y + COLLISION_OFFSET < height || y + BIRD_SIZE - COLLISION_OFFSET > height + PIPE_GAP;
+}
+
+bool loadDpTable(const char* path);   // mmap, từ chối nếu luật chơi trong header khác bản build
+void unloadDpTable();
+bool dpTableLoaded();
+
+// Ngoài phạm vi bảng thì trả false
+bool dpSurvivable(int y, int v, int d, int gapTop);
+
+// Quyết định tra bảng O(1); false nếu chưa nạp bảng hoặc ống kế tiếp còn xa hơn DP_D_MAX (đầu ván)
+bool dpDecide(const SimState& s, bool& jump);
+
+#endif
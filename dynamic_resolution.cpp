@@ -0,0 +1,79 @@
+#include "dynamic_resolution.h"
+
+static const float LEVELS[] = {1.0f, 0.85f, 0.75f, 0.625f, 0.5f};
+const int LEVEL_COUNT = sizeof(LEVELS) / sizeof(LEVELS[0]);
+const int DOWNSCALE_HOLD = 30;     // số khung tối thiểu giữa 2 lần hạ độ phân giải
+const int UPSCALE_HOLD = 180;      // nâng lên chậm hơn để không dao động qua lại
+
+static SDL_Texture* targets[LEVEL_COUNT] = {};  // tạo sẵn hết để đổi mức không phải cấp phát
+static int baseWidth = 0, baseHeight = 0;
+static int level = 0;
+static bool enabled = false;
+
+static Uint64 sceneStart = 0;
+static double frameEma = 0, workEma = 0;
+static int holdFrames = 0;
+
+bool initDynamicResolution(SDL_Renderer* renderer, int width, int height) {
+    baseWidth = width;
+    baseHeight = height;
+    SDL_RenderSetLogicalSize(renderer, width, height);
+    if (!SDL_RenderTargetSupported(renderer)) return false;
+
+    for (int i = 0; i < LEVEL_COUNT; i++) {
+        targets[i] = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                                       (int)(width * LEVELS[i]), (int)(height * LEVELS[i]));
+        if (!targets[i]) {
+            destroyDynamicResolution();
+            return false;
+        }
+        SDL_SetTextureScaleMode(targets[i], SDL_ScaleModeLinear);
+    }
+    enabled = true;
+    return true;
+}
+
+void beginScene(SDL_Renderer* renderer) {
+    sceneStart = SDL_GetPerformanceCounter();
+    if (!enabled) return;
+    SDL_SetRenderTarget(renderer, targets[level]);
+    SDL_RenderSetScale(renderer, LEVELS[level], LEVELS[level]);
+}
+
+int endScene(SDL_Renderer* renderer) {
+    double workMs = (double)(SDL_GetPerformanceCounter() - sceneStart) * 1000.0 / SDL_GetPerformanceFrequency();
+    workEma = workEma * 0.9 + workMs * 0.1;
+    if (!enabled) return 0;
+
+    SDL_SetRenderTarget(renderer, NULL);// SDL khôi phục logical size của cửa sổ
+    SDL_Rect src = {0, 0, (int)(baseWidth * LEVELS[level]), (int)(baseHeight * LEVELS[level])};
+    SDL_RenderCopy(renderer, targets[level], &src, NULL);
+    return 1;
+}
+
+void dynamicResolutionFrame(double frameMs, double targetMs) {
+    frameEma = frameEma * 0.9 + frameMs * 0.1;
+    if (!enabled) return;
+    holdFrames++;
+
+    // trễ khung rõ rệt thì hạ ngay, còn nâng lên phải dư nhiều thời gian trong lâu hơn
+    if (frameEma > targetMs * 1.15 && level < LEVEL_COUNT - 1 && holdFrames >= DOWNSCALE_HOLD) {
+        level++;
+        holdFrames = 0;
+    } else if (frameEma < targetMs * 1.05 && workEma < targetMs * 0.4 && level > 0 && holdFrames >= UPSCALE_HOLD) {
+        level--;
+        holdFrames = 0;
+    }
+}
+
+float resolutionScale() {
+    return enabled ? LEVELS[level] : 1.0f;
+}
+
+void destroyDynamicResolution() {
+    for (int i = 0; i < LEVEL_COUNT; i++) {
+        SDL_DestroyTexture(targets[i]);
+        targets[i] = nullptr;
+    }
+    enabled = false;
+}
@@ -0,0 +1,14 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <SDL2/SDL.h>
+
+// Vẽ cảnh vào texture đích có độ phân giải thay đổi theo thời gian khung, rồi phóng lên cửa sổ
+bool initDynamicResolution(SDL_Renderer* renderer, int width, int height);
+void beginScene(SDL_Renderer* renderer);   // gắn texture đích, mọi lệnh vẽ vẫn dùng toạ độ width x height
+int endScene(SDL_Renderer* renderer);      // trả về cửa sổ và phóng texture lên, trả về số lệnh vẽ
+void dynamicResolutionFrame(double frameMs, double targetMs);
+float resolutionScale();
+void destroyDynamicResolution();
+
+#endif
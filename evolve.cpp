@@ -0,0 +1,199 @@
+#include "nn_policy.h"
+#include "autopilot.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Huấn luyện policy bằng tiến hoá, chạy headless trên luật của sim.h.
+// Mỗi thế hệ mọi cá thể chơi cùng GAMES_PER_EVAL seed (công bằng), song song trên mọi lõi;
+// giữ ELITE cá thể tốt nhất, phần còn lại sinh từ chọn lọc tournament + lai đều + đột biến Gauss.
+const int HIDDEN = 8;
+const int GAMES_PER_EVAL = NN_BLOCK;    // 1 khối SoA = các ván của 1 cá thể chạy song song
+const int MAX_TICKS = 3600;
+const int ELITE = 8;
+const int TOURNAMENT = 3;
+const float MUTATION_RATE = 0.1f;
+const float MUTATION_SIGMA = 0.3f;
+const int CALIBRATION_STATES = 4096;
+
+struct Genome {
+    vector<float> genes;
+    double fitness = 0;
+    double meanScore = 0;
+};
+
+static const int DIMS[] = {NN_INPUTS, HIDDEN, HIDDEN, 1};
+static const int LAYERS = 3;
+
+static int geneCount() {
+    int count = 0;
+    for (int l = 0; l < LAYERS; l++) count += DIMS[l] * DIMS[l + 1] + DIMS[l + 1];
+    return count;
+}
+
+static void genesToModel(const vector<float>& genes, NnModel& model) {
+    int g = 0;
+    for (int l = 0; l < model.layerCount; l++) {
+        for (float& w : model.layers[l].weights) w = genes[g++];
+        for (float& b : model.layers[l].bias) b = genes[g++];
+    }
+}
+
+static void modelToGenes(const NnModel& model, vector<float>& genes) {
+    genes.clear();
+    for (int l = 0; l < model.layerCount; l++) {
+        genes.insert(genes.end(), model.layers[l].weights.begin(), model.layers[l].weights.end());
+        genes.insert(genes.end(), model.layers[l].bias.begin(), model.layers[l].bias.end());
+    }
+}
+
+static float uniform(uint32_t& rng) {
+    return (simRandom(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+static float gaussian(uint32_t& rng) {
+    float u = max(uniform(rng), 1e-7f);
+    return sqrtf(-2 * logf(u)) * cosf(6.2831853f * uniform(rng));
+}
+
+// Chơi GAMES_PER_EVAL ván cùng lúc; độ thích nghi = số tick sống trung bình
+static void evaluate(Genome& genome, NnModel& model, uint32_t firstSeed, long long& ticks) {
+    genesToModel(genome.genes, model);
+    SimState games[GAMES_PER_EVAL];
+    for (int b = 0; b < GAMES_PER_EVAL; b++) simSeed(games[b], firstSeed + b);
+
+    float soa[NN_INPUTS * GAMES_PER_EVAL];
+    uint8_t jump[GAMES_PER_EVAL];
+    int alive = GAMES_PER_EVAL;
+    while (alive > 0) {
+        nnGatherFeatures(games, GAMES_PER_EVAL, soa, GAMES_PER_EVAL);
+        nnEvaluate(model, NN_FLOAT_AVX2, soa, GAMES_PER_EVAL, GAMES_PER_EVAL, jump);
+        alive = 0;
+        for (int b = 0; b < GAMES_PER_EVAL; b++) {
+            if (games[b].gameOver || (int)games[b].tick >= MAX_TICKS) continue;
+            simStep(games[b], jump[b]);
+            alive += !games[b].gameOver && (int)games[b].tick < MAX_TICKS;
+        }
+    }
+    long long total = 0, score = 0;
+    for (const SimState& s : games) {
+        total += s.tick;
+        score += s.score;
+    }
+    ticks += total;
+    genome.fitness = (double)total / GAMES_PER_EVAL;
+    genome.meanScore = (double)score / GAMES_PER_EVAL;
+}
+
+static const Genome& tournament(const vector<Genome>& population, uint32_t& rng) {
+    const Genome* best = &population[simRandom(rng) % population.size()];
+    for (int i = 1; i < TOURNAMENT; i++) {
+        const Genome& other = population[simRandom(rng) % population.size()];
+        if (other.fitness > best->fitness) best = &other;
+    }
+    return *best;
+}
+
+static bool saveBest(const Genome& best, NnModel& model, const vector<float>& calibration, const char* path) {
+    genesToModel(best.genes, model);
+    calibrateNnModel(model, calibration.data(), CALIBRATION_STATES, CALIBRATION_STATES);// thang int8 cho game
+    return saveNnModel(model, path);
+}
+
+int main(int argc, char* argv[]) {
+    int generations = argc > 1 ? atoi(argv[1]) : 300;
+    int populationSize = argc > 2 ? atoi(argv[2]) : 256;
+    const char* path = argc > 3 ? argv[3] : "policy.nn";
+    int threadCount = max(1, (int)thread::hardware_concurrency());
+    populationSize = max(populationSize, ELITE + 1);
+
+    NnModel model;
+    initNnModel(model, DIMS, LAYERS);
+    uint32_t rng = 0xC0FFEEu;
+    vector<Genome> population(populationSize);
+    for (Genome& genome : population) {
+        genome.genes.resize(geneCount());
+        for (float& gene : genome.genes) gene = gaussian(rng) * 0.5f;
+    }
+    // có checkpoint cùng kích thước thì đi tiếp từ đó; nó là bản đang lưu, chỉ bị thay khi có cá thể thắng nó
+    Genome saved;
+    NnModel resumed;
+    if (loadNnModel(resumed, path) && resumed.layerCount == LAYERS && resumed.layers[0].out == HIDDEN && resumed.layers[1].out == HIDDEN) {
+        modelToGenes(resumed, saved.genes);
+        population[0].genes = saved.genes;
+        printf("resuming from %s\n", path);
+    }
+
+    // trạng thái thật để hiệu chỉnh thang int8 trước khi lưu
+    vector<float> calibration(NN_INPUTS * CALIBRATION_STATES);
+    {
+        vector<SimState> states;
+        for (uint32_t seed = 1; (int)states.size() < CALIBRATION_STATES; seed++) {
+            SimState s;
+            simSeed(s, seed);
+            while (!s.gameOver && (int)states.size() < CALIBRATION_STATES && s.tick < 2000) {
+                states.push_back(s);
+                simStep(s, autopilotDecide(s));
+            }
+        }
+        nnGatherFeatures(states.data(), CALIBRATION_STATES, calibration.data(), CALIBRATION_STATES);
+    }
+
+    vector<NnModel> models(threadCount, model);
+    printf("%d genomes x %d games, %d genes, %d threads\n", populationSize, GAMES_PER_EVAL, geneCount(), threadCount);
+    printf("%4s %10s %10s %10s %9s %12s %12s\n", "gen", "best", "mean", "bestScore", "ms", "games/s", "Mticks/s");
+    for (int gen = 0; gen < generations; gen++) {
+        uint32_t firstSeed = 1000003u * (gen + 1);// mọi cá thể cùng bộ seed, đổi mỗi thế hệ để không học thuộc
+        atomic<int> next{0};
+        vector<long long> ticks(threadCount, 0);
+        auto start = chrono::steady_clock::now();
+        vector<thread> workers;
+        for (int t = 0; t < threadCount; t++) {
+            workers.emplace_back([&, t] {
+                for (int i = next++; i < populationSize; i = next++) evaluate(population[i], models[t], firstSeed, ticks[t]);
+            });
+        }
+        for (auto& worker : workers) worker.join();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        sort(population.begin(), population.end(), [](const Genome& a, const Genome& b) { return a.fitness > b.fitness; });
+        double mean = 0;
+        long long totalTicks = 0;
+        for (const Genome& genome : population) mean += genome.fitness;
+        for (long long t : ticks) totalTicks += t;
+        mean /= populationSize;
+        printf("%4d %10.1f %10.1f %10.1f %9.1f %12.0f %12.2f\n", gen, population[0].fitness, mean, population[0].meanScore, ms,
+               populationSize * GAMES_PER_EVAL / (ms / 1e3), totalTicks / (ms * 1e3));
+        fflush(stdout);
+
+        // seed đổi mỗi thế hệ nên điểm cũ của bản đang lưu không so được: chấm lại nó trên seed thế hệ này rồi mới so
+        long long recheckTicks = 0;// ngoài phần đo thời gian ở trên
+        if (!saved.genes.empty()) evaluate(saved, models[0], firstSeed, recheckTicks);
+        if (saved.genes.empty() || population[0].fitness > saved.fitness) {
+            saved = population[0];
+            if (!saveBest(saved, model, calibration, path)) printf("cannot write %s\n", path);
+        }
+
+        vector<Genome> children(population.begin(), population.begin() + ELITE);
+        while ((int)children.size() < populationSize) {
+            const Genome& a = tournament(population, rng);
+            const Genome& b = tournament(population, rng);
+            Genome child;
+            child.genes.resize(a.genes.size());
+            for (size_t g = 0; g < child.genes.size(); g++) {
+                child.genes[g] = simRandom(rng) & 1 ? a.genes[g] : b.genes[g];
+                if (uniform(rng) < MUTATION_RATE) child.genes[g] += gaussian(rng) * MUTATION_SIGMA;
+            }
+            children.push_back(move(child));
+        }
+        population.swap(children);
+    }
+    printf("saved fitness %.1f ticks (last generation's seeds), saved to %s\n", saved.fitness, path);
+    return 0;
+}
@@ -0,0 +1,58 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include "sim.h"
+#include <cstdint>
+
+// Số cố định Q23.8 cho vị trí và vận tốc: 1/256 pixel, chỉ cộng trừ nhân nguyên và dịch bit,
+// nên kết quả giống hệt nhau giữa mọi trình biên dịch, mức tối ưu, bản vô hướng và SIMD (float thì không).
+// y trên màn hình cần 18 bit nên làn SIMD là int32.
+typedef int32_t Fixed;
+const int FIXED_SHIFT = 8;
+const Fixed FIXED_ONE = 1 << FIXED_SHIFT;
+
+constexpr Fixed toFixed(int pixels) {
+    return pixels * FIXED_ONE;
+}
+
+// dịch phải số học = làm tròn xuống, C++20 đã định nghĩa cho số âm
+constexpr int fixedFloor(Fixed f) {
+    return f >> FIXED_SHIFT;
+}
+
+const Fixed FX_GRAVITY = toFixed(GRAVITY);
+const Fixed FX_JUMP = toFixed(JUMP_STRENGTH);
+const Fixed FX_GROUND_Y = toFixed(SCREEN_HEIGHT - GROUND_HEIGHT - BIRD_SIZE);// y >= mốc này là chạm đất
+
+// Như simStepBird() nhưng trong số cố định; phần lẻ = 0 thì trùng khớp từng bit với bản pixel
+inline int fixedStepBird(Fixed& y, Fixed& velocity, bool jump) {
+    int events = 0;
+    if (jump) velocity = FX_JUMP;
+
+    velocity += FX_GRAVITY;
+    y += velocity;
+    if (y < 0) {
+        y = 0;
+        velocity = 0;
+        events |= SIM_HIT_CEILING;
+    }
+    if (y >= FX_GROUND_Y) events |= SIM_HIT_GROUND;
+    return events;
+}
+
+// Như simHitsPipe() cho chim ở độ cao y lẻ pixel; ống đi nguyên PIPE_SPEED pixel mỗi tick nên giữ x nguyên
+inline bool fixedHitsPipe(const SimState& s, Fixed y) {
+    const int hitLeft = BIRD_X + COLLISION_OFFSET;
+    const int hitRight = BIRD_X + BIRD_SIZE - COLLISION_OFFSET;
+    for (int i = 0; i < s.pipeCount; i++) {
+        const Pipe& pipe = s.pipes[i];
+        if (hitRight > pipe.x && hitLeft < pipe.x + PIPE_WIDTH) {
+            if (y + toFixed(COLLISION_OFFSET) < toFixed(pipe.height) ||
+                y + toFixed(BIRD_SIZE - COLLISION_OFFSET) > toFixed(pipe.height + pipe.gap))
+                return true;
+        }
+    }
+    return false;
+}
+
+#endif
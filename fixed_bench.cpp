@@ -0,0 +1,91 @@
+#include "fixed_step.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+
+// Kiểm tra số cố định: bản AVX2 trùng từng bit với bản vô hướng, phần lẻ = 0 thì trùng với simStepBird() pixel,
+// rồi đo tốc độ bước chim theo lô. Checksum in ra để so giữa các bản build (-O0/-O3, trình biên dịch khác).
+const int DEFAULT_BIRDS = 100000;
+const int TICKS = 600;
+
+static uint64_t fnv(uint64_t hash, const void* data, size_t bytes) {
+    const uint8_t* p = (const uint8_t*)data;
+    for (size_t i = 0; i < bytes; i++) hash = (hash ^ p[i]) * 1099511628211ull;
+    return hash;
+}
+
+struct Flock {
+    vector<Fixed> y, velocity;
+    vector<uint8_t> dead;
+};
+
+static void spawn(Flock& flock, int birds) {
+    uint32_t rng = 2024;
+    flock.y.resize(birds);
+    flock.velocity.resize(birds);
+    flock.dead.assign(birds, 0);
+    for (int i = 0; i < birds; i++) {
+        flock.y[i] = (Fixed)(simRandom(rng) % FX_GROUND_Y);
+        flock.velocity[i] = toFixed(-15) + (Fixed)(simRandom(rng) % toFixed(30));
+    }
+}
+
+// trả về checksum trạng thái sau TICKS tick; chim chạm đất thì thả lại giữa màn hình để lô luôn đầy
+static uint64_t run(FixedKernel kernel, int birds, const vector<uint8_t>& jumps, double& seconds) {
+    Flock flock;
+    spawn(flock, birds);
+    uint64_t hash = 1469598103934665603ull;
+    seconds = 0;
+    for (int t = 0; t < TICKS; t++) {
+        auto start = chrono::steady_clock::now();
+        stepBirdsFixed(kernel, flock.y.data(), flock.velocity.data(), &jumps[(size_t)t * birds], birds, flock.dead.data());
+        seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        hash = fnv(hash, flock.dead.data(), birds);
+        for (int i = 0; i < birds; i++) {
+            if (flock.dead[i]) flock.y[i] = toFixed(SCREEN_HEIGHT / 2) + (i & 255);
+        }
+    }
+    hash = fnv(hash, flock.y.data(), birds * sizeof(Fixed));
+    return fnv(hash, flock.velocity.data(), birds * sizeof(Fixed));
+}
+
+int main(int argc, char* argv[]) {
+    int birds = argc > 1 ? atoi(argv[1]) : DEFAULT_BIRDS;
+    if (birds <= 0) birds = DEFAULT_BIRDS;
+
+    // lẻ pixel = 0 thì phải trùng khớp luật pixel của sim.h
+    uint32_t rng = 99;
+    long long pixelMismatch = 0;
+    for (int i = 0; i < 1000000; i++) {
+        int y = (int)(simRandom(rng) % 700) - 100, v = (int)(simRandom(rng) % 60) - 30;
+        bool jump = simRandom(rng) & 1;
+        Fixed fy = toFixed(y), fv = toFixed(v);
+        int events = simStepBird(y, v, jump);
+        int fixedEvents = fixedStepBird(fy, fv, jump);
+        pixelMismatch += events != fixedEvents || fy != toFixed(y) || fv != toFixed(v);
+    }
+    printf("fixed vs pixel rules on 1M integral states: %lld mismatches\n", pixelMismatch);
+
+    vector<uint8_t> jumps((size_t)birds * TICKS);
+    for (uint8_t& jump : jumps) jump = simRandom(rng) % 20 == 0;
+    printf("%d birds x %d ticks\n%-8s %12s %10s %18s\n", birds, TICKS, "kernel", "Mbirds/s", "ns/bird", "checksum");
+    uint64_t reference = 0;
+    bool identical = true;
+    for (FixedKernel kernel : {FIXED_SCALAR, FIXED_AVX2}) {
+        if (!fixedKernelSupported(kernel)) {
+            printf("%-8s %12s\n", fixedKernelName(kernel), "unsupported");
+            continue;
+        }
+        double seconds;
+        uint64_t hash = run(kernel, birds, jumps, seconds);
+        if (kernel == FIXED_SCALAR) reference = hash;
+        identical &= hash == reference;
+        double steps = (double)birds * TICKS;
+        printf("%-8s %12.1f %10.3f %18llx\n", fixedKernelName(kernel), steps / seconds / 1e6, seconds * 1e9 / steps,
+               (unsigned long long)hash);
+    }
+    printf("kernels %s\n", identical ? "bit-identical" : "DIFFER");
+    return identical && pixelMismatch == 0 ? 0 : 1;
+}
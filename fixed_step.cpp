@@ -0,0 +1,59 @@
+#include "fixed_step.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FIXED_HAVE_AVX2 1
+#include <immintrin.h>
+#endif
+
+static void stepScalar(Fixed* y, Fixed* velocity, const uint8_t* jump, int begin, int count, uint8_t* dead) {
+    for (int i = begin; i < count; i++) dead[i] = (fixedStepBird(y[i], velocity[i], jump[i]) & SIM_HIT_GROUND) != 0;
+}
+
+#ifdef FIXED_HAVE_AVX2
+// trả về số chim đã xử lý (bội của 8), phần đuôi để bản vô hướng làm
+__attribute__((target("avx2")))
+static int stepAvx2(Fixed* y, Fixed* velocity, const uint8_t* jump, int count, uint8_t* dead) {
+    const __m256i jumpVelocity = _mm256_set1_epi32(FX_JUMP);
+    const __m256i gravity = _mm256_set1_epi32(FX_GRAVITY);
+    const __m256i ground = _mm256_set1_epi32(FX_GROUND_Y - 1);
+    const __m256i zero = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i yv = _mm256_loadu_si256((const __m256i*)(y + i));
+        __m256i vv = _mm256_loadu_si256((const __m256i*)(velocity + i));
+        __m256i jumps = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(jump + i)));
+        __m256i jumping = _mm256_cmpgt_epi32(jumps, zero);
+        vv = _mm256_blendv_epi8(vv, jumpVelocity, jumping);
+        vv = _mm256_add_epi32(vv, gravity);
+        yv = _mm256_add_epi32(yv, vv);
+        __m256i ceiling = _mm256_cmpgt_epi32(zero, yv);// y < 0: kẹp y và vận tốc về 0
+        yv = _mm256_andnot_si256(ceiling, yv);
+        vv = _mm256_andnot_si256(ceiling, vv);
+        _mm256_storeu_si256((__m256i*)(y + i), yv);
+        _mm256_storeu_si256((__m256i*)(velocity + i), vv);
+        int hits = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(yv, ground)));
+        for (int k = 0; k < 8; k++) dead[i + k] = (hits >> k) & 1;
+    }
+    return i;
+}
+#endif
+
+bool fixedKernelSupported(FixedKernel kernel) {
+    if (kernel == FIXED_SCALAR) return true;
+#ifdef FIXED_HAVE_AVX2
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+const char* fixedKernelName(FixedKernel kernel) {
+    return kernel == FIXED_AVX2 ? "avx2" : "scalar";
+}
+
+void stepBirdsFixed(FixedKernel kernel, Fixed* y, Fixed* velocity, const uint8_t* jump, int count, uint8_t* dead) {
+    int done = 0;
+#ifdef FIXED_HAVE_AVX2
+    if (kernel == FIXED_AVX2 && fixedKernelSupported(kernel)) done = stepAvx2(y, velocity, jump, count, dead);
+#endif
+    stepScalar(y, velocity, jump, done, count, dead);
+}
@@ -0,0 +1,19 @@
+#ifndef FIXED_STEP_H
+#define FIXED_STEP_H
+
+#include "fixed.h"
+#include <cstdint>
+
+// Bước chim theo lô trong số cố định: bản AVX2 xử lý 8 chim (8 làn int32) mỗi lần,
+// kết quả giống hệt từng bit với bản vô hướng và với fixedStepBird().
+enum FixedKernel {
+    FIXED_SCALAR,
+    FIXED_AVX2,
+};
+
+bool fixedKernelSupported(FixedKernel kernel);
+const char* fixedKernelName(FixedKernel kernel);
+// dead[i] = 1 nếu chim i chạm đất ở tick này; kernel không hỗ trợ thì lùi về FIXED_SCALAR
+void stepBirdsFixed(FixedKernel kernel, Fixed* y, Fixed* velocity, const uint8_t* jump, int count, uint8_t* dead);
+
+#endif
@@ -0,0 +1,53 @@
+#include "flight_recorder.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+// In nội dung file flight recorder dạng bảng
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "usage: flight_decode <flight.bin>" << endl;
+        return 2;
+    }
+    ifstream file(argv[1], ios::binary);
+    if (!file.is_open()) {
+        cerr << "cannot open " << argv[1] << endl;
+        return 1;
+    }
+
+    FlightHeader header;
+    if (!file.read((char*)&header, sizeof(header)) || memcmp(header.magic, FLIGHT_MAGIC, 4) != 0) {
+        cerr << "not a flight recorder file" << endl;
+        return 1;
+    }
+    if (header.version != FLIGHT_VERSION || header.recordSize != sizeof(FlightRecord)) {
+        cerr << "unsupported version " << header.version << " record size " << header.recordSize << endl;
+        return 1;
+    }
+
+    vector<FlightRecord> records(header.count);
+    file.read((char*)records.data(), (streamsize)(records.size() * sizeof(FlightRecord)));
+    records.resize(file.gcount() / sizeof(FlightRecord));
+
+    if ((header.reason & 0xff) == FLIGHT_REASON_CRASH) printf("reason: crash (signal %u)\n", header.reason >> 8);
+    else printf("reason: game over\n");
+    printf("records: %zu\n", records.size());
+    printf("%8s %5s %5s %5s %-6s  pipes (x,height,gap)\n", "tick", "y", "vel", "score", "flags");
+
+    for (const FlightRecord& r : records) {
+        char flags[7] = "------";
+        if (r.flags & FLIGHT_JUMP) flags[0] = 'J';
+        if (r.flags & FLIGHT_SCORED) flags[1] = 'S';
+        if (r.flags & FLIGHT_HIT_CEILING) flags[2] = 'C';
+        if (r.flags & FLIGHT_HIT_GROUND) flags[3] = 'G';
+        if (r.flags & FLIGHT_HIT_PIPE) flags[4] = 'P';
+        if (r.flags & FLIGHT_REWOUND) flags[5] = 'R';
+        printf("%8u %5d %5d %5u %-6s ", r.tick, r.birdY, r.birdVelocity, r.score, flags);
+        for (int i = 0; i < r.pipeCount && i < FLIGHT_MAX_PIPES; i++) printf(" (%d,%d,%d)", r.pipes[i].x, r.pipes[i].height, r.pipes[i].gap);
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include "flight_recorder.h"
+#include <atomic>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <thread>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+using namespace std;
+
+static FlightRecord ring[FLIGHT_RING_SIZE];
+static atomic<uint32_t> ringHead{0};
+
+// bản chụp cho thread ghi, chỉ chép khi game over
+static FlightRecord snapshot[FLIGHT_RING_SIZE];
+static uint32_t snapshotCount = 0;
+static atomic<bool> snapshotBusy{false};
+
+static const char* gameOverFile = nullptr;
+static const char* crashFile = nullptr;
+static thread writerThread;
+static mutex writerMutex;
+static condition_variable writerWake;
+static bool writerPending = false;
+static bool writerStop = false;
+
+FlightRecord& flightNextRecord() {
+    return ring[ringHead.load(memory_order_relaxed) & (FLIGHT_RING_SIZE - 1)];
+}
+
+void flightCommit() {
+    ringHead.store(ringHead.load(memory_order_relaxed) + 1, memory_order_release);
+}
+
+// Vị trí bản ghi cũ nhất và độ dài đoạn trước khi ring quay vòng
+static void ringSpan(uint32_t head, uint32_t& start, uint32_t& count, uint32_t& first) {
+    count = head < FLIGHT_RING_SIZE ? head : FLIGHT_RING_SIZE;
+    start = (head - count) & (FLIGHT_RING_SIZE - 1);
+    first = FLIGHT_RING_SIZE - start < count ? FLIGHT_RING_SIZE - start : count;
+}
+
+static void writeSnapshot() {
+    FlightHeader header;
+    memcpy(header.magic, FLIGHT_MAGIC, 4);
+    header.version = FLIGHT_VERSION;
+    header.recordSize = sizeof(FlightRecord);
+    header.count = snapshotCount;
+    header.reason = FLIGHT_REASON_GAME_OVER;
+
+    FILE* file = fopen(gameOverFile, "wb");
+    if (file) {
+        fwrite(&header, sizeof(header), 1, file);
+        fwrite(snapshot, sizeof(FlightRecord), snapshotCount, file);
+        fclose(file);
+    }
+}
+
+void flightDumpGameOver() {
+    if (!gameOverFile || snapshotBusy.exchange(true)) return;// thread ghi chưa xong lần trước
+
+    uint32_t start, count, first;
+    ringSpan(ringHead.load(memory_order_acquire), start, count, first);
+    memcpy(snapshot, ring + start, first * sizeof(FlightRecord));
+    memcpy(snapshot + first, ring, (count - first) * sizeof(FlightRecord));
+    snapshotCount = count;
+
+    {
+        lock_guard<mutex> lock(writerMutex);
+        writerPending = true;
+    }
+    writerWake.notify_one();
+}
+
+// Chỉ dùng open/write vì handler signal không được cấp phát hay khoá
+static void crashHandler(int sig) {
+#ifdef _WIN32
+    int fd = _open(crashFile, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, 0644);
+#else
+    int fd = open(crashFile, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    if (fd >= 0) {
+        uint32_t start, count, first;
+        ringSpan(ringHead.load(memory_order_acquire), start, count, first);
+
+        FlightHeader header;
+        memcpy(header.magic, FLIGHT_MAGIC, 4);
+        header.version = FLIGHT_VERSION;
+        header.recordSize = sizeof(FlightRecord);
+        header.count = count;
+        header.reason = FLIGHT_REASON_CRASH | ((uint32_t)sig << 8);
+#ifdef _WIN32
+        _write(fd, &header, sizeof(header));
+        _write(fd, ring + start, first * sizeof(FlightRecord));
+        _write(fd, ring, (count - first) * sizeof(FlightRecord));
+        _close(fd);
+#else
+        (void)!write(fd, &header, sizeof(header));
+        (void)!write(fd, ring + start, first * sizeof(FlightRecord));
+        (void)!write(fd, ring, (count - first) * sizeof(FlightRecord));
+        close(fd);
+#endif
+    }
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+void startFlightRecorder(const char* gameOverPath, const char* crashPath) {
+    gameOverFile = gameOverPath;
+    crashFile = crashPath;
+    writerStop = false;
+    writerThread = thread([]() {
+        unique_lock<mutex> lock(writerMutex);
+        while (true) {
+            writerWake.wait(lock, [] { return writerPending || writerStop; });
+            if (writerPending) {
+                writerPending = false;
+                lock.unlock();
+                writeSnapshot();
+                snapshotBusy.store(false);
+                lock.lock();
+            }
+            if (writerStop) break;
+        }
+    });
+
+    signal(SIGSEGV, crashHandler);
+    signal(SIGABRT, crashHandler);
+    signal(SIGFPE, crashHandler);
+    signal(SIGILL, crashHandler);
+}
+
+void stopFlightRecorder() {
+    if (!writerThread.joinable()) return;
+    {
+        lock_guard<mutex> lock(writerMutex);
+        writerStop = true;
+    }
+    writerWake.notify_one();
+    writerThread.join();
+}
@@ -0,0 +1,58 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <cstdint>
+
+// Định dạng file: FlightHeader rồi header.count bản ghi FlightRecord, cũ nhất trước, little-endian
+const char FLIGHT_MAGIC[4] = {'F', 'L', 'R', 'C'};
+const uint16_t FLIGHT_VERSION = 3;    // 2: FlightPipe có gap; 3: tick = SimState::tick, cờ FLIGHT_REWOUND
+const int FLIGHT_MAX_PIPES = 6;
+const int FLIGHT_RING_SIZE = 4096;  // ~68 giây ở 60 Hz, phải là lũy thừa của 2
+
+enum FlightFlags : uint8_t {
+    FLIGHT_JUMP = 1,        // có input nhảy trong tick này
+    FLIGHT_SCORED = 2,
+    FLIGHT_HIT_GROUND = 4,
+    FLIGHT_HIT_PIPE = 8,
+    FLIGHT_HIT_CEILING = 16,// bị chặn ở y < 0
+    FLIGHT_REWOUND = 32,    // tick đầu tiên sau khi tua lại, các bản ghi trước đó là nhánh đã bỏ
+};
+
+enum FlightReason : uint32_t {
+    FLIGHT_REASON_GAME_OVER = 1,
+    FLIGHT_REASON_CRASH = 2,
+};
+
+struct FlightPipe {
+    int16_t x;
+    int16_t height;
+    int16_t gap;            // đường ống sinh dần đổi khe theo từng ống
+};
+
+struct FlightRecord {
+    uint32_t tick;          // SimState::tick của ván, về 0 mỗi ván mới, lùi lại khi tua
+    int16_t birdY;
+    int16_t birdVelocity;
+    uint16_t score;
+    uint8_t flags;
+    uint8_t pipeCount;
+    FlightPipe pipes[FLIGHT_MAX_PIPES];
+};
+static_assert(sizeof(FlightRecord) == 48, "FlightRecord must stay packed");
+
+struct FlightHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t recordSize;
+    uint32_t count;
+    uint32_t reason;        // FlightReason, hoặc số hiệu signal << 8 khi crash
+};
+static_assert(sizeof(FlightHeader) == 16, "FlightHeader must stay packed");
+
+void startFlightRecorder(const char* gameOverPath, const char* crashPath);
+void stopFlightRecorder();
+FlightRecord& flightNextRecord();   // ghi trực tiếp vào ring (mọi trường) rồi gọi flightCommit()
+void flightCommit();
+void flightDumpGameOver();          // chụp ring và giao cho thread ghi file
+
+#endif
@@ -0,0 +1,110 @@
+#include "frame_pacer.h"
+#include <cmath>
+#include <iostream>
+using namespace std;
+
+static Uint64 perfFreq = 0;
+static Uint64 framePeriod = 0;      // độ dài 1 khung hiển thị (tick counter)
+static Uint64 spinTicks = 0;        // đoạn cuối chờ bằng spin thay vì ngủ
+static Uint64 nextDeadline = 0;
+static Uint64 lastFrame = 0;
+
+static FrameStats stats;
+static double frameSum = 0, jitterSum = 0, jitterSqSum = 0;
+
+void initFramePacer(SDL_Window* window, SDL_Renderer* renderer) {
+    perfFreq = SDL_GetPerformanceFrequency();
+
+    int refresh = 0;
+    SDL_DisplayMode mode;
+    if (SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(window), &mode) == 0) refresh = mode.refresh_rate;
+    if (refresh <= 0) refresh = SIM_HZ;// driver không báo tần số quét
+
+    SDL_RendererInfo info;
+    bool vsync = SDL_GetRendererInfo(renderer, &info) == 0 && (info.flags & SDL_RENDERER_PRESENTVSYNC);
+
+    framePeriod = perfFreq / refresh;
+    spinTicks = perfFreq * 15 / 10000;// 1.5 ms, lớn hơn độ phân giải timer của OS
+
+    lastFrame = SDL_GetPerformanceCounter();
+    nextDeadline = lastFrame + framePeriod;
+
+    resetFrameStats();
+    stats.targetMs = 1000.0 / refresh;
+    stats.vsync = vsync;
+    stats.refreshRate = refresh;
+}
+
+void sleepUntil(Uint64 deadline) {
+    if (!perfFreq) perfFreq = SDL_GetPerformanceFrequency();
+    if (!spinTicks) spinTicks = perfFreq * 15 / 10000;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    while (now + spinTicks < deadline) {
+        Uint32 ms = (Uint32)((deadline - now - spinTicks) * 1000 / perfFreq);
+        if (ms == 0) break;
+        SDL_Delay(ms);
+        now = SDL_GetPerformanceCounter();
+    }
+    while (SDL_GetPerformanceCounter() < deadline) {
+    }// spin phần dưới 1 ms cuối
+}
+
+static void recordFrame(Uint64 now) {
+    double dtMs = (double)(now - lastFrame) * 1000.0 / (double)perfFreq;
+    lastFrame = now;
+    stats.lastFrameMs = dtMs;
+
+    double jitter = fabs(dtMs - stats.targetMs);
+    stats.frames++;
+    frameSum += dtMs;
+    jitterSum += jitter;
+    jitterSqSum += jitter * jitter;
+
+    double n = (double)stats.frames;
+    stats.meanMs = frameSum / n;
+    stats.jitterMeanMs = jitterSum / n;
+    stats.jitterStdDevMs = sqrt(fmax(0.0, jitterSqSum / n - stats.jitterMeanMs * stats.jitterMeanMs));
+    if (jitter > stats.jitterMaxMs) stats.jitterMaxMs = jitter;
+    if (dtMs > stats.targetMs * 1.5) stats.missedFrames++;
+}
+
+void waitNextFrame() {
+    // có vsync thì SDL_RenderPresent đã chặn tới lần quét kế tiếp
+    if (!stats.vsync) {
+        sleepUntil(nextDeadline);
+
+        nextDeadline += framePeriod;
+        Uint64 now = SDL_GetPerformanceCounter();
+        if (nextDeadline < now) nextDeadline = now + framePeriod;// khung quá dài thì bắt nhịp lại, không đuổi theo
+    }
+    recordFrame(SDL_GetPerformanceCounter());
+}
+
+void resumeFramePacer() {
+    lastFrame = SDL_GetPerformanceCounter();
+    nextDeadline = lastFrame + framePeriod;
+}
+
+const FrameStats& frameStats() {
+    return stats;
+}
+
+void resetFrameStats() {
+    double target = stats.targetMs;
+    bool vsync = stats.vsync;
+    int refresh = stats.refreshRate;
+    stats = {};
+    stats.targetMs = target;
+    stats.vsync = vsync;
+    stats.refreshRate = refresh;
+    frameSum = jitterSum = jitterSqSum = 0;
+}
+
+void logFrameStats() {
+    cout << "Frames: " << stats.frames
+         << " refresh: " << stats.refreshRate << " Hz" << (stats.vsync ? " (vsync)" : "")
+         << " mean: " << stats.meanMs << " ms"
+         << " jitter mean/stddev/max: " << stats.jitterMeanMs << "/" << stats.jitterStdDevMs << "/" << stats.jitterMaxMs << " ms"
+         << " missed: " << stats.missedFrames << endl;
+}
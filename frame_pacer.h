@@ -0,0 +1,31 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <SDL2/SDL.h>
+
+const int SIM_HZ = 60;          // tần số cập nhật vật lý cố định
+const int MAX_SIM_STEPS = 5;    // giới hạn số bước bù khi bị trễ
+
+// Thống kê thời gian khung hình (ms)
+struct FrameStats {
+    Uint64 frames = 0;
+    double targetMs = 0;
+    double meanMs = 0;
+    double lastFrameMs = 0;
+    double jitterMeanMs = 0;    // trung bình |dt - target|
+    double jitterStdDevMs = 0;
+    double jitterMaxMs = 0;
+    Uint64 missedFrames = 0;    // khung dài hơn 1.5 lần mục tiêu
+    bool vsync = false;
+    int refreshRate = 0;
+};
+
+void initFramePacer(SDL_Window* window, SDL_Renderer* renderer);
+void sleepUntil(Uint64 deadline);   // ngủ rồi spin tới thời điểm performance counter cho trước
+void waitNextFrame();           // ngủ rồi spin tới hạn khung kế tiếp
+void resumeFramePacer();        // gọi sau khi đứng chờ sự kiện, để khoảng nghỉ không bị tính là khung trễ
+const FrameStats& frameStats();
+void resetFrameStats();
+void logFrameStats();
+
+#endif
@@ -0,0 +1,114 @@
+#include "glyph_atlas.h"
+
+bool buildGlyphAtlas(SDL_Renderer* renderer, TTF_Font* font, GlyphAtlas& atlas) {
+    if (!font) return false;
+
+    const int columns = 16;
+    int cellW = 0, cellH = TTF_FontHeight(font);
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        int minx, maxx, miny, maxy, adv;
+        if (TTF_GlyphMetrics(font, GLYPH_FIRST + i, &minx, &maxx, &miny, &maxy, &adv) == 0) {
+            atlas.advance[i] = adv;
+            if (adv > cellW) cellW = adv;
+            if (maxx > cellW) cellW = maxx;
+        }
+    }
+    cellW += 2;// chừa viền để lọc tuyến tính không lem sang ô bên cạnh
+    cellH += 2;
+
+    int rows = (GLYPH_COUNT + 1 + columns - 1) / columns;// +1 cho ô trắng
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, columns * cellW, rows * cellH, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) return false;
+    SDL_FillRect(surface, NULL, SDL_MapRGBA(surface->format, 255, 255, 255, 0));
+
+    SDL_Color white = {255, 255, 255, 255};
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        SDL_Rect dst = {(i % columns) * cellW + 1, (i / columns) * cellH + 1, 0, 0};
+        SDL_Surface* glyph = TTF_RenderGlyph_Blended(font, GLYPH_FIRST + i, white);
+        if (glyph) {
+            SDL_SetSurfaceBlendMode(glyph, SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(glyph, NULL, surface, &dst);
+            dst.w = glyph->w;
+            dst.h = glyph->h;
+            SDL_FreeSurface(glyph);
+        }
+        atlas.glyphs[i] = dst;
+    }
+
+    SDL_Rect whiteCell = {(GLYPH_COUNT % columns) * cellW + 1, (GLYPH_COUNT / columns) * cellH + 1, 4, 4};
+    SDL_FillRect(surface, &whiteCell, SDL_MapRGBA(surface->format, 255, 255, 255, 255));
+    atlas.white = {whiteCell.x + 1, whiteCell.y + 1, 2, 2};
+
+    atlas.texture = SDL_CreateTextureFromSurface(renderer, surface);
+    atlas.width = surface->w;
+    atlas.height = surface->h;
+    atlas.lineHeight = TTF_FontHeight(font);
+    SDL_FreeSurface(surface);
+    if (!atlas.texture) return false;
+    SDL_SetTextureBlendMode(atlas.texture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+void destroyGlyphAtlas(GlyphAtlas& atlas) {
+    SDL_DestroyTexture(atlas.texture);
+    atlas.texture = nullptr;
+}
+
+static void pushQuad(QuadBatch& batch, const GlyphAtlas& atlas, float x, float y, float w, float h, const SDL_Rect& src, SDL_Color color) {
+    if (batch.quads >= QUAD_BATCH_MAX) return;
+    float u0 = (float)src.x / atlas.width, v0 = (float)src.y / atlas.height;
+    float u1 = (float)(src.x + src.w) / atlas.width, v1 = (float)(src.y + src.h) / atlas.height;
+
+    int base = batch.quads * 4;
+    SDL_Vertex* v = &batch.vertices[base];
+    v[0] = {{x, y}, color, {u0, v0}};
+    v[1] = {{x + w, y}, color, {u1, v0}};
+    v[2] = {{x + w, y + h}, color, {u1, v1}};
+    v[3] = {{x, y + h}, color, {u0, v1}};
+
+    int* idx = &batch.indices[batch.quads * 6];
+    idx[0] = base; idx[1] = base + 1; idx[2] = base + 2;
+    idx[3] = base; idx[4] = base + 2; idx[5] = base + 3;
+    batch.quads++;
+}
+
+void batchRect(QuadBatch& batch, const GlyphAtlas& atlas, float x, float y, float w, float h, SDL_Color color) {
+    pushQuad(batch, atlas, x, y, w, h, atlas.white, color);
+}
+
+float batchText(QuadBatch& batch, const GlyphAtlas& atlas, float x, float y, float scale, const char* text, SDL_Color color) {
+    return batchTextScaled(batch, atlas, x, y, scale, scale, text, color);
+}
+
+float batchTextScaled(QuadBatch& batch, const GlyphAtlas& atlas, float x, float y, float sx, float sy, const char* text, SDL_Color color) {
+    for (const char* c = text; *c; c++) {
+        int i = (unsigned char)*c - GLYPH_FIRST;
+        if (i < 0 || i >= GLYPH_COUNT) continue;
+        const SDL_Rect& g = atlas.glyphs[i];
+        if (*c != ' ') pushQuad(batch, atlas, x, y, g.w * sx, g.h * sy, g, color);
+        x += atlas.advance[i] * sx;
+    }
+    return x;
+}
+
+void batchTextInRect(QuadBatch& batch, const GlyphAtlas& atlas, const SDL_Rect& rect, const char* text, SDL_Color color) {
+    float w = textWidth(atlas, 1, text);
+    if (w <= 0 || atlas.lineHeight <= 0) return;
+    batchTextScaled(batch, atlas, (float)rect.x, (float)rect.y, rect.w / w, (float)rect.h / atlas.lineHeight, text, color);
+}
+
+float textWidth(const GlyphAtlas& atlas, float scale, const char* text) {
+    float w = 0;
+    for (const char* c = text; *c; c++) {
+        int i = (unsigned char)*c - GLYPH_FIRST;
+        if (i >= 0 && i < GLYPH_COUNT) w += atlas.advance[i] * scale;
+    }
+    return w;
+}
+
+int flushBatch(SDL_Renderer* renderer, const GlyphAtlas& atlas, QuadBatch& batch) {
+    if (batch.quads == 0) return 0;
+    SDL_RenderGeometry(renderer, atlas.texture, batch.vertices, batch.quads * 4, batch.indices, batch.quads * 6);
+    batch.quads = 0;
+    return 1;
+}
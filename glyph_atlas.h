@@ -0,0 +1,39 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+const int GLYPH_FIRST = 32;     // ' '
+const int GLYPH_COUNT = 95;     // tới '~'
+
+// Toàn bộ ký tự ASCII rasterize 1 lần vào 1 texture
+struct GlyphAtlas {
+    SDL_Texture* texture = nullptr;
+    int width = 0, height = 0;
+    int lineHeight = 0;
+    SDL_Rect glyphs[GLYPH_COUNT] = {};
+    int advance[GLYPH_COUNT] = {};
+    SDL_Rect white = {};        // ô trắng để vẽ khối màu trong cùng lần gọi
+};
+
+bool buildGlyphAtlas(SDL_Renderer* renderer, TTF_Font* font, GlyphAtlas& atlas);
+void destroyGlyphAtlas(GlyphAtlas& atlas);
+
+// Bộ đệm đỉnh cố định, gom quad lại để vẽ bằng 1 lần SDL_RenderGeometry
+const int QUAD_BATCH_MAX = 1024;
+
+struct QuadBatch {
+    SDL_Vertex vertices[QUAD_BATCH_MAX * 4];
+    int indices[QUAD_BATCH_MAX * 6];
+    int quads = 0;
+};
+
+void batchRect(QuadBatch& batch, const GlyphAtlas& atlas, float x, float y, float w, float h, SDL_Color color);
+float batchText(QuadBatch& batch, const GlyphAtlas& atlas, float x, float y, float scale, const char* text, SDL_Color color);
+float batchTextScaled(QuadBatch& batch, const GlyphAtlas& atlas, float x, float y, float sx, float sy, const char* text, SDL_Color color);
+void batchTextInRect(QuadBatch& batch, const GlyphAtlas& atlas, const SDL_Rect& rect, const char* text, SDL_Color color);// kéo giãn chữ vừa khung như SDL_RenderCopy
+float textWidth(const GlyphAtlas& atlas, float scale, const char* text);
+int flushBatch(SDL_Renderer* renderer, const GlyphAtlas& atlas, QuadBatch& batch);
+
+#endif
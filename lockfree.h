@@ -0,0 +1,68 @@
+#ifndef LOCKFREE_H
+#define LOCKFREE_H
+
+#include <atomic>
+#include <cstdint>
+
+// Hàng đợi 1 producer 1 consumer, kích thước cố định, không khoá
+template <typename T, int N>
+class SpscQueue {
+    static_assert((N & (N - 1)) == 0, "N must be a power of two");
+
+public:
+    bool push(const T& item) {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == N) return false;// đầy
+        items[tail & (N - 1)] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    bool pop(T& item) {
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+        item = items[head & (N - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T items[N] = {};
+    alignas(64) std::atomic<uint32_t> head_{0};
+    alignas(64) std::atomic<uint32_t> tail_{0};
+};
+
+// Triple buffer: writer luôn có 1 slot riêng để ghi, reader luôn đọc được bản mới nhất đã publish
+template <typename T>
+class TripleBuffer {
+public:
+    T& writeBuffer() { return slots[back]; }
+
+    void publish() {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Đổi sang bản mới nhất nếu có, trả về true khi đã đổi
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    const T& readBuffer() const { return slots[front]; }
+
+private:
+    static const int INDEX_MASK = 3;
+    static const int FRESH = 4;
+
+    T slots[3] = {};
+    int back = 0;                       // chỉ writer dùng
+    alignas(64) std::atomic<int> middle{1};
+    alignas(64) int front = 2;          // chỉ reader dùng
+};
+
+#endif
@@ -2,20 +2,37 @@
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 #include <SDL2/SDL_mixer.h>
-#include <vector>
 #include <iostream>
 #include<fstream>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <cmath>
+#include "frame_pacer.h"
+#include "profiler.h"
+#include "alloc_tracker.h"
+#include "perf_hud.h"
+#include "glyph_atlas.h"
+#include "metrics.h"
+#include "flight_recorder.h"
+#include "lockfree.h"
+#include "dynamic_resolution.h"
+#include "sim.h"
+#include "autopilot.h"
+#include "dp_table.h"
+#include "planner.h"
+#include "nn_policy.h"
+#include "population.h"
+#include "sprite_batch.h"
+#include "pixel_mask.h"
+#include "seed_index.h"
+#include "course.h"
+#include "rewind.h"
 using namespace std;
 
-const int SCREEN_WIDTH = 800;
-const int SCREEN_HEIGHT = 600;
-const int GRAVITY = 1;
-const int JUMP_STRENGTH = -15;
-const int PIPE_WIDTH = 80;
-const int PIPE_GAP = 200;
-const int PIPE_SPEED = 3;
-const int GROUND_HEIGHT = 100;
-
 SDL_Window* window = nullptr;
 SDL_Renderer* renderer = nullptr;
 SDL_Texture* background = nullptr;
@@ -24,8 +41,15 @@ SDL_Texture* pipeTexture = nullptr;
 SDL_Texture* groundTexture = nullptr;
 SDL_Texture* playButtonTexture = nullptr;
 SDL_Texture* gameOverTexture = nullptr;
+PixelMask birdMask;             // alpha của chim.png, cot.png ở kích thước vẽ
+PixelMask pipeMasks[SIM_VARIANT_COUNT];// ống theo bề rộng của từng biến thể luật
+bool pixelCollision = false;    // người chơi dùng va chạm từng pixel; bot giữ hitbox chữ nhật đã giải/huấn luyện theo,
+                                // đường ống sinh dần và seed đã chấm cũng vậy (hiện trên màn hình)
 
 TTF_Font* font = nullptr;
+TTF_Font* hudFont = nullptr;
+GlyphAtlas textAtlas;
+QuadBatch textBatch;
 
 Mix_Chunk* soundJump = nullptr;
 Mix_Chunk* soundHit = nullptr;
@@ -33,32 +57,119 @@ Mix_Chunk* soundPoint = nullptr;
 Mix_Chunk* soundGameOver = nullptr;
 
 
-int collisionOffset = 15;
-int score = 0;
 int highScore = 0;
 
-struct Pipe {
-    int x, height;
-    bool scored = false;
-};
-
-vector<Pipe> pipes;
-SDL_Rect bird = {100, SCREEN_HEIGHT / 2, 70,70};//vị tris , kích thước chim
+SimState world;// chim, ống, điểm; chỉ thread mô phỏng chạm vào
+float seedBandLo = 0, seedBandHi = 1;// dải độ khó khi có seed_index.bin, đổi bằng --seed-band lo:hi
+uint32_t seedPickRng = 1;
+bool rankedSeed = false;// ván đang chơi lấy seed từ chỉ mục; seed_rank chấm bằng hitbox chữ nhật nên ván này cũng vậy
 SDL_Rect playButton = {SCREEN_WIDTH / 2 - 50, SCREEN_HEIGHT / 2 - 25, 100, 50};//vị trí,kích thước nút play
-int birdVelocity = 0;//vận toocs
 
-bool isRunning = true;
-bool gameOver = false;
+atomic<bool> isRunning{true};
 bool gameStarted = false;
 bool showMenu = true;
 bool showGameOverScreen = false;
+SimVariant gameVariant = SIM_CLASSIC;// luật chơi, phím V đổi vòng hoặc --variant tên
+bool jumpInput = false;// có nhảy kể từ lần update() trước
+bool rewound = false;// vừa tua lại, đánh dấu bản ghi flight recorder kế tiếp
+enum BotMode {
+    BOT_OFF,
+    BOT_AUTOPILOT,          // tra bảng DP / công thức đóng
+    BOT_PLANNER,            // beam search, mạnh nhất
+    BOT_NEURAL,             // mạng nơ-ron từ policy.nn, chỉ có khi nạp được file
+    BOT_MODE_COUNT,
+};
+int botMode = BOT_OFF;// chế độ tự chơi (attract mode), phím A đổi vòng
+int attractWait = 0;
+Planner planner;
+bool plannerReady = false;
+NnModel policy;
+bool policyLoaded = false;
+Population population;// chế độ đàn chim, phím P
+bool populationMode = false;
+CourseStream course;// đường ống sinh dần theo đường cong độ khó, phím C
+bool courseMode = false;
+const int REWIND_SECONDS = 10;
+RewindBuffer history;// tua lại khi luyện tập, phím Backspace lùi 1 giây
+SpriteBatch birdBatch;
+SDL_Color flockColors[32];
+
+const int ATTRACT_RESTART_TICKS = 2 * SIM_HZ;// tự chơi lại sau 2 giây ở màn hình game over
+
+// Thread vẽ chỉ đọc ảnh chụp này, không chạm vào trạng thái của thread mô phỏng
+struct FrameSnapshot {
+    SDL_Rect bird;
+    Pipe pipes[MAX_PIPES];
+    int pipeCount;
+    int pipeWidth;
+    const char* modeName;       // chuỗi hằng, hiện ở menu
+    const char* hitboxNote;     // chuỗi hằng khi người chơi phải dùng hitbox chữ nhật dù có mask pixel, không thì nullptr
+    int score;
+    int highScore;
+    bool showMenu;
+    bool showGameOverScreen;
+    int populationCount;        // > 0 thì vẽ đàn chim thay cho 1 chim
+    Fixed populationY[POPULATION_MAX];  // lẻ pixel, đỉnh float của SDL_RenderGeometry vẽ được
+    Uint16 populationId[POPULATION_MAX];
+};
+
+enum InputCommand : Uint8 {
+    INPUT_FLAP,             // phím cách
+    INPUT_TOGGLE_AUTOPILOT, // phím A
+    INPUT_TOGGLE_POPULATION,// phím P
+    INPUT_TOGGLE_COURSE,    // phím C
+    INPUT_REWIND,           // phím Backspace
+    INPUT_CYCLE_VARIANT,    // phím V
+};
 
-SDL_Texture* loadTexture(const char* path) {
+SpscQueue<InputCommand, 64> inputQueue;     // thread chính -> thread mô phỏng
+TripleBuffer<FrameSnapshot> frameBuffer;    // thread mô phỏng -> thread chính
+atomic<Uint32> inputSignal{0};              // đánh thức thread mô phỏng khi đang ngủ ở màn hình chờ
+Uint32 simWakeEvent = 0;                    // sự kiện SDL báo thread chính có ảnh chụp mới khi đang chờ
+
+const int IDLE_WAIT_MS = 500;
+Uint64 wakeStart = 0;                       // lúc bấm phím ở màn hình chờ, 0 nếu không đo
+bool wakeFromMenu = false, wakeFromGameOver = false;
+Uint64 wakeCount = 0;
+double wakeSumMs = 0, wakeMaxMs = 0;
+
+// Nén alpha của surface thành bitmask maskWidth x maskHeight (0 = kích thước ảnh)
+void buildSurfaceMask(SDL_Surface* surface, PixelMask& mask, int maskWidth, int maskHeight) {
+    SDL_Surface* rgba = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    if (!rgba) return;
+    SDL_LockSurface(rgba);
+    const Uint8* alpha = (const Uint8*)rgba->pixels + 3;// RGBA32: byte thứ 4 mỗi pixel
+    buildPixelMask(mask, alpha, rgba->w, rgba->h, rgba->pitch, 4, maskWidth ? maskWidth : rgba->w,
+                   maskHeight ? maskHeight : rgba->h);
+    SDL_UnlockSurface(rgba);
+    SDL_FreeSurface(rgba);
+}
+
+// mask != nullptr thì nén luôn alpha thành bitmask maskWidth x maskHeight (0 = kích thước ảnh)
+SDL_Texture* loadTexture(const char* path, PixelMask* mask = nullptr, int maskWidth = 0, int maskHeight = 0) {
+    PROFILE_ZONE("loadTexture");
     SDL_Surface* surface = IMG_Load(path);
+    if (!surface) return nullptr;
     SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    frameCounters.textureUploads++;
+    if (mask) buildSurfaceMask(surface, *mask, maskWidth, maskHeight);
     SDL_FreeSurface(surface);
     return texture;
 }
+
+// Mask ống cho các biến thể có bề rộng ống khác luật gốc; mask ngang không giãn được lúc thử nên dựng sẵn từng bề rộng
+void loadVariantPipeMasks(const char* path) {
+    SDL_Surface* surface = IMG_Load(path);
+    if (!surface) return;
+    for (int v = 0; v < SIM_VARIANT_COUNT; v++)
+        if (v != SIM_CLASSIC) buildSurfaceMask(surface, pipeMasks[v], SIM_VARIANT_RULES[v].pipeWidth, 0);
+    SDL_FreeSurface(surface);
+}
+
+// Đường ống sinh dần không dùng hàm này (luôn hitbox chữ nhật, xem course.h)
+bool pixelPipeTest(const SimState& s, int y) {
+    return pixelHitsPipe(s, y, birdMask, pipeMasks[gameVariant]);
+}
 // Hàm lưu điểm cao vào file
 void saveHighScore(int score) {
     ofstream file("highscore.txt");
@@ -68,6 +179,33 @@ void saveHighScore(int score) {
     }
 }
 
+// Ván chỉ thật sự kết thúc khi rời màn hình game over (chơi lại, về menu, đổi chế độ) hoặc thoát game: còn tua lại
+// được thì lần chết trước chưa phải kết quả. Lúc đó mới ghi metrics và flight dump, ring đã có cả dòng thời gian cuối.
+// Ván bỏ ngang (chưa chết) không tính.
+void finishGame() {
+    if (!world.gameOver) return;
+    metricAdd(METRIC_GAMES_PLAYED);
+    metricObserve(METRIC_GAME_SCORE, world.score);
+    flightDumpGameOver();
+}
+
+// Ván mới: có chỉ mục độ khó thì lấy seed trong dải đã chọn để mọi ván khó ngang nhau, không thì đi tiếp chuỗi rng.
+// Chế độ đường ống sinh dần và biến thể luật thì chỉ mục (chấm theo luật gốc) không áp dụng.
+// Ván lấy seed từ chỉ mục chơi bằng hitbox chữ nhật như lúc chấm, để độ khó đúng như đã chọn (hiện trên màn hình).
+void startGame() {
+    uint32_t seed;
+    finishGame();
+    clearRewind(history);
+    rankedSeed = false;
+    if (courseMode) {
+        simReset(world);
+        initCourse(course, simRandom(seedPickRng));
+    } else if (gameVariant == SIM_CLASSIC && pickSeed(seedBandLo, seedBandHi, seedPickRng, seed)) {
+        simSeed(world, seed);
+        rankedSeed = true;
+    } else simReset(world);
+}
+
 // Hàm tải điểm cao từ file
 int loadHighScore() {
     ifstream file("highscore.txt");
@@ -80,174 +218,442 @@ int loadHighScore() {
 }
 
 void init() {
+    PROFILE_THREAD("main");
+    PROFILE_ZONE("init");
+    installSdlAllocHooks();
     SDL_Init(SDL_INIT_VIDEO);
     IMG_Init(IMG_INIT_PNG);
     TTF_Init();
     window = SDL_CreateWindow("Flappy Bird", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, SCREEN_WIDTH, SCREEN_HEIGHT, 0);
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE);
+    initDynamicResolution(renderer, SCREEN_WIDTH, SCREEN_HEIGHT);
     background = loadTexture("background.png");
-    birdTexture = loadTexture("chim.png");
-    pipeTexture = loadTexture("cot.png");
+    birdTexture = loadTexture("chim.png", &birdMask, BIRD_SIZE, BIRD_SIZE);
+    pipeTexture = loadTexture("cot.png", &pipeMasks[SIM_CLASSIC], PIPE_WIDTH);// chiều cao ống thay đổi, giãn hàng lúc thử
+    loadVariantPipeMasks("cot.png");
+    pixelCollision = birdMask.top < birdMask.bottom;// ảnh lỗi/trong suốt hết thì giữ hitbox chữ nhật
+    for (const PixelMask& mask : pipeMasks) pixelCollision &= mask.top < mask.bottom;
     groundTexture = loadTexture("ground.png");
     playButtonTexture = loadTexture("play_button.jpg");
     gameOverTexture = loadTexture("GAME_OVER.png");
 
-    font = TTF_OpenFont("PressStart2P-Regular.ttf", 24);
+    {
+        PROFILE_ZONE("loadFont");
+        font = TTF_OpenFont("PressStart2P-Regular.ttf", 24);
+        hudFont = TTF_OpenFont("PressStart2P-Regular.ttf", 16);
+        buildGlyphAtlas(renderer, font, textAtlas);
+        initPerfHud(renderer, hudFont);
+    }
 
 
 
     Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048);
-
-    soundJump = Mix_LoadWAV("jump.wav");
-    soundHit = Mix_LoadWAV("hit.wav");
-    soundPoint = Mix_LoadWAV("point.wav");
-    soundGameOver = Mix_LoadWAV("gameover.wav");
+    installAudioUnderrunProbe(44100, 2048);
+
+    {
+        PROFILE_ZONE("loadSounds");
+        soundJump = Mix_LoadWAV("jump.wav");
+        soundHit = Mix_LoadWAV("hit.wav");
+        soundPoint = Mix_LoadWAV("point.wav");
+        soundGameOver = Mix_LoadWAV("gameover.wav");
+    }
 
     int highScore = loadHighScore();  // Tải điểm cao từ file khi game bắt đầu
+    simSeed(world, (Uint32)time(nullptr));
+    seedPickRng = (Uint32)time(nullptr);
+
+    initFramePacer(window, renderer);
+    startMetricsExporter("metrics.prom", 1000);
+    startFlightRecorder("flight_gameover.bin", "flight_crash.bin");
+    if (loadDpTable("dp_table.bin")) cout << "Loaded dp_table.bin for autopilot" << endl;// không có thì dùng autopilot giải tích
+    // seed_rank chạy headless chỉ chấm được bằng hitbox chữ nhật; ván dùng seed này cũng chơi bằng hitbox đó (startGame)
+    if (loadSeedIndex("seed_index.bin", SEED_HITBOX_RECT)) {
+        cout << "Loaded seed_index.bin, difficulty band " << seedBandLo << ".." << seedBandHi << endl;
+        startGame();
+    }
+    policyLoaded = loadNnModel(policy, "policy.nn");
+    initSpriteBatch(birdBatch, POPULATION_MAX);
+    initRewind(history, REWIND_SECONDS * SIM_HZ);
+    for (int i = 0; i < 32; i++) {
+        // bảng màu theo vòng hue, alpha thấp để thấy chỗ đàn dày
+        float h = i * 6.0f / 32, x = 1 - fabsf(fmodf(h, 2) - 1);
+        float rgb[6][3] = {{1, x, 0}, {x, 1, 0}, {0, 1, x}, {0, x, 1}, {x, 0, 1}, {1, 0, x}};
+        float* c = rgb[(int)h];
+        flockColors[i] = {(Uint8)(128 + 127 * c[0]), (Uint8)(128 + 127 * c[1]), (Uint8)(128 + 127 * c[2]), 160};
+    }
+    simWakeEvent = SDL_RegisterEvents(1);
+}
+
 
+
+void wakeSimulation() {
+    inputSignal.fetch_add(1);
+    inputSignal.notify_one();
 }
 
+// Xử lý 1 sự kiện, trả về true nếu màn hình cần vẽ lại
+bool handleEvent(const SDL_Event& event) {
+    if (event.type == SDL_QUIT) {
+        isRunning = false;
+        wakeSimulation();
+    }
 
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F9) {
+        PROFILE_DUMP("trace.json");
+    }// ghi trace Chrome/Perfetto
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F3) {
+        togglePerfHud();
+        return true;
+    }
 
-void handleInput() {
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_SPACE) {
+        inputQueue.push(INPUT_FLAP);
+        wakeSimulation();
+    }
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_a) {
+        inputQueue.push(INPUT_TOGGLE_AUTOPILOT);
+        wakeSimulation();
+    }
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_p) {
+        inputQueue.push(INPUT_TOGGLE_POPULATION);
+        wakeSimulation();
+    }
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_c) {
+        inputQueue.push(INPUT_TOGGLE_COURSE);
+        wakeSimulation();
+    }
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_BACKSPACE) {
+        inputQueue.push(INPUT_REWIND);
+        wakeSimulation();
+    }
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_v) {
+        inputQueue.push(INPUT_CYCLE_VARIANT);
+        wakeSimulation();
+    }
+
+    if (event.type == simWakeEvent) return true;
+    if (event.type == SDL_WINDOWEVENT && (event.window.event == SDL_WINDOWEVENT_EXPOSED
+                                          || event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED
+                                          || event.window.event == SDL_WINDOWEVENT_RESTORED)) return true;
+    return false;
+}
+
+bool handleInput() {
+    PROFILE_ZONE("handleInput");
+    bool redraw = false;
     SDL_Event event;
-    while (SDL_PollEvent(&event)) {
-        if (event.type == SDL_QUIT) isRunning = false;
+    while (SDL_PollEvent(&event)) redraw |= handleEvent(event);
+    return redraw;
+}
 
-        if (showMenu && event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_SPACE) {
-            showMenu = false;
+// Chạy trên thread mô phỏng
+void applyInput(InputCommand command) {
+    if (command == INPUT_TOGGLE_AUTOPILOT) {
+        botMode = (botMode + 1) % BOT_MODE_COUNT;
+        if (botMode == BOT_NEURAL && !policyLoaded) botMode = BOT_OFF;
+        attractWait = 0;
+        if (botMode == BOT_PLANNER && !plannerReady) {
+            PlannerConfig config;
+            config.threads = min(4, (int)thread::hardware_concurrency());
+            initPlanner(planner, config);// cấp phát arena 1 lần, ngoài vòng lặp mô phỏng
+            plannerReady = true;
+        }
+        return;
+    }
+    if (command == INPUT_TOGGLE_POPULATION) {
+        populationMode = !populationMode;
+        if (populationMode) spawnPopulation(population, POPULATION_MAX, (Uint32)time(nullptr));
+        showMenu = !populationMode;// tắt thì về menu, ván đang chơi bỏ
+        showGameOverScreen = false;
+        gameStarted = false;
+        startGame();
+        return;
+    }
+    if (command == INPUT_TOGGLE_COURSE || command == INPUT_CYCLE_VARIANT) {
+        if (command == INPUT_TOGGLE_COURSE) courseMode = !courseMode;
+        else gameVariant = (SimVariant)((gameVariant + 1) % SIM_VARIANT_COUNT);
+        showMenu = !populationMode;// ván đang chơi bỏ, giống phím P
+        showGameOverScreen = false;
+        gameStarted = false;
+        startGame();
+        return;
+    }
+    if (populationMode) return;
+    if (command == INPUT_REWIND) {
+        // đường ống sinh dần đã sinh trước theo thời gian, không lùi được cùng world
+        if (courseMode || showMenu) return;
+        int back = min(SIM_HZ, rewindAvailable(history));
+        if (back > 0 && rewindTo(history, back, world)) {
+            rewound = true;
+            showGameOverScreen = false;// lùi về trước lúc chết thì chơi tiếp
             gameStarted = true;
+            jumpInput = false;
         }
+        return;
+    }
 
-        if (!showMenu && !showGameOverScreen && event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_SPACE && !gameOver) {
-            birdVelocity = JUMP_STRENGTH;//Vt=sức nhảy
-            Mix_PlayChannel(-1, soundJump, 0);
-        }
+    if (showMenu) {
+        showMenu = false;
+        gameStarted = true;
+    }
 
-        if (showGameOverScreen && event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_SPACE) {
+    if (!showMenu && !showGameOverScreen && !world.gameOver) {
+        jumpInput = true;//Vt=sức nhảy, áp dụng ở simStep() kế tiếp
+        Mix_PlayChannel(-1, soundJump, 0);
+    }
 
-            gameOver = false;
-            showGameOverScreen = false;
-            gameStarted = false;
-            showMenu = true;
-            bird.y = SCREEN_HEIGHT / 2;
-            birdVelocity = 0;
-            score = 0;
-            pipes.clear();
-        }
+    if (showGameOverScreen) {
+
+        showGameOverScreen = false;
+        gameStarted = false;
+        showMenu = true;
+        startGame();
     }
 }
-void renderScore() {
+void renderScore(int score) {
+    PROFILE_ZONE("renderScore");
     SDL_Color white = {255, 255, 255, 255}; // Màu trắng
-    string scoreText = "Score: " + to_string(score);
-
-
-    SDL_Surface* surfaceMessage = TTF_RenderText_Solid(font, scoreText.c_str(), white);
-    SDL_Texture* message = SDL_CreateTextureFromSurface(renderer, surfaceMessage);
+    char scoreText[32];
+    snprintf(scoreText, sizeof(scoreText), "Score: %d", score);
 
 
     SDL_Rect messageRect = {SCREEN_WIDTH - 150, 20, 130, 30};
 
 
-    SDL_RenderCopy(renderer, message, NULL, &messageRect);
-    SDL_FreeSurface(surfaceMessage);
-    SDL_DestroyTexture(message);
+    batchTextInRect(textBatch, textAtlas, messageRect, scoreText, white);// vẽ từ atlas, không tạo texture mỗi khung
 }
 
 void update() {
+    PROFILE_ZONE("update");
     if (showMenu) return;
     if (!gameStarted) return;
-    if (gameOver) {
-        if (score > highScore) {
-            highScore = score;  // Cập nhật điểm cao nhất nếu điểm hiện tại lớn hơn
+    if (world.gameOver) {
+        if (world.score > highScore) {
+            highScore = world.score;  // Cập nhật điểm cao nhất nếu điểm hiện tại lớn hơn
             saveHighScore(highScore);  // Lưu điểm cao vào file
         }
         showGameOverScreen = true;
         return;
     }
 
-    birdVelocity += GRAVITY;
-    bird.y += birdVelocity;
-// vị trí , vân tốc chim
-    if (bird.y<0) {
-        bird.y = 0;
-        birdVelocity = 0;
+    Uint8 flightFlags = jumpInput ? FLIGHT_JUMP : 0;
+    if (rewound) flightFlags |= FLIGHT_REWOUND;
+    rewound = false;
+    int events;
+    SimPipeTest hitsPipe = pixelCollision && botMode == BOT_OFF && !rankedSeed ? pixelPipeTest : nullptr;
+    if (courseMode) events = courseStep(course, world, jumpInput);// ống, khe, tốc độ theo đường cong độ khó; hitbox chữ nhật
+    else {
+        // chọn biến thể 1 lần mỗi tick, trong nhánh thì luật là hằng số; vật lý nằm trong sim.h
+        events = simDispatch(gameVariant, [&]<SimRules R>() { return simStep<R>(world, jumpInput, hitsPipe); });
     }
-    if (bird.y + bird.h >= SCREEN_HEIGHT - GROUND_HEIGHT) {
-        gameOver = true;
+    jumpInput = false;
+    recordRewind(history, world);
+
+    if (events & SIM_HIT_CEILING) flightFlags |= FLIGHT_HIT_CEILING;
+    if (events & SIM_HIT_GROUND) {
+        flightFlags |= FLIGHT_HIT_GROUND;
         Mix_PlayChannel(-1, soundGameOver, 0);
+    }//chim chạm đất
+    if (events & SIM_SCORED) {
+        flightFlags |= FLIGHT_SCORED;
+        Mix_PlayChannel(-1, soundPoint, 0);
     }
-//chim chạm đất
-    for (auto& pipe : pipes) pipe.x -= PIPE_SPEED;
-    if (!pipes.empty() && pipes[0].x < -PIPE_WIDTH) pipes.erase(pipes.begin());
-//di chuyển , xoá ống cũ
-    if (pipes.empty() || pipes.back().x < SCREEN_WIDTH - 300) {
-        int randomHeight = rand() % (SCREEN_HEIGHT - GROUND_HEIGHT - PIPE_GAP - 200) + 100;
-        pipes.push_back({SCREEN_WIDTH, randomHeight});
-    }// chiều cao ngẫu nhiên
-
-    SDL_Rect birdHitbox = {bird.x + collisionOffset, bird.y + collisionOffset, bird.w - 2 * collisionOffset, bird.h - 2 * collisionOffset};
-    for (auto& pipe : pipes) {
-        if (bird.x > pipe.x + PIPE_WIDTH && !pipe.scored) {
-            pipe.scored = true;
-            score++;
-            Mix_PlayChannel(-1, soundPoint, 0);
-        }// tránh va chạm giả , tăng score khi qua ống
-
-        if (birdHitbox.x + birdHitbox.w > pipe.x && birdHitbox.x < pipe.x + PIPE_WIDTH) {
-            if (birdHitbox.y < pipe.height || birdHitbox.y + birdHitbox.h > pipe.height + PIPE_GAP) {
-                gameOver = true;
-                Mix_PlayChannel(-1, soundHit, 0);
-            } // hitbox chim dính vào ống
-        }
-    }
+    if (events & SIM_HIT_PIPE) {
+        flightFlags |= FLIGHT_HIT_PIPE;
+        Mix_PlayChannel(-1, soundHit, 0);
+    }// hitbox chim dính vào ống
+
+    FlightRecord& rec = flightNextRecord();
+    rec.tick = world.tick;
+    rec.birdY = world.birdY;
+    rec.birdVelocity = world.birdVelocity;
+    rec.score = world.score;
+    rec.flags = flightFlags;
+    rec.pipeCount = world.pipeCount < FLIGHT_MAX_PIPES ? world.pipeCount : FLIGHT_MAX_PIPES;
+    for (int i = 0; i < rec.pipeCount; i++) rec.pipes[i] = {(Sint16)world.pipes[i].x, (Sint16)world.pipes[i].height, world.pipes[i].gap};
+    flightCommit();
 }
 
-void renderHighScore() {
+void renderHighScore(int highScore) {
+    PROFILE_ZONE("renderHighScore");
     SDL_Color white = {255, 255, 255, 255};  // Màu trắng
-    string highScoreText = "High Score: " + to_string(highScore);
-
-    SDL_Surface* surfaceMessage = TTF_RenderText_Solid(font, highScoreText.c_str(), white);
-    SDL_Texture* message = SDL_CreateTextureFromSurface(renderer, surfaceMessage);
+    char highScoreText[32];
+    snprintf(highScoreText, sizeof(highScoreText), "High Score: %d", highScore);
 
     SDL_Rect messageRect = {SCREEN_WIDTH - 300, 20, 150, 30};
 
-    SDL_RenderCopy(renderer, message, NULL, &messageRect);
-    SDL_FreeSurface(surfaceMessage);
-    SDL_DestroyTexture(message);
+    batchTextInRect(textBatch, textAtlas, messageRect, highScoreText, white);
 }
 
 
 
-void render() {
+void render(const FrameSnapshot& frame) {
+    PROFILE_ZONE("render");
+    SDL_RenderClear(renderer);
+    beginScene(renderer);
     SDL_RenderClear(renderer);
     SDL_RenderCopy(renderer, background, NULL, NULL);
+    frameCounters.drawCalls++;
 
-    if (showMenu) {
+    if (frame.showMenu) {
         SDL_RenderCopy(renderer, playButtonTexture, NULL, &playButton);
+        frameCounters.drawCalls++;
+        char modeText[32];
+        snprintf(modeText, sizeof(modeText), "Mode: %s", frame.modeName);
+        SDL_Rect modeRect = {SCREEN_WIDTH / 2 - 100, playButton.y + playButton.h + 20, 200, 20};
+        batchTextInRect(textBatch, textAtlas, modeRect, modeText, {255, 255, 255, 255});
     }//màn hình menu
-    else if (showGameOverScreen) {
+    else if (frame.showGameOverScreen) {
         SDL_Rect gameOverRect = {SCREEN_WIDTH / 2 - 150, SCREEN_HEIGHT / 3, 300, 100};
         SDL_RenderCopy(renderer, gameOverTexture, NULL, &gameOverRect);
+        frameCounters.drawCalls++;
     }//màn hinh gameover
     else {
-        for (const auto& pipe : pipes) {
-            SDL_Rect pipeTop = {pipe.x, 0, PIPE_WIDTH, pipe.height};
-            SDL_Rect pipeBottom = {pipe.x, pipe.height + PIPE_GAP, PIPE_WIDTH, SCREEN_HEIGHT - pipe.height - PIPE_GAP - GROUND_HEIGHT};
+        for (int i = 0; i < frame.pipeCount; i++) {
+            const Pipe& pipe = frame.pipes[i];
+            SDL_Rect pipeTop = {pipe.x, 0, frame.pipeWidth, pipe.height};
+            SDL_Rect pipeBottom = {pipe.x, pipe.height + pipe.gap, frame.pipeWidth, SCREEN_HEIGHT - pipe.height - pipe.gap - GROUND_HEIGHT};
             SDL_RenderCopyEx(renderer, pipeTexture, NULL, &pipeTop, 0, NULL, SDL_FLIP_VERTICAL);
             SDL_RenderCopy(renderer, pipeTexture, NULL, &pipeBottom);
+            frameCounters.drawCalls += 2;
         }// vẽ ống trên dưới
 
-        SDL_RenderCopy(renderer, birdTexture, NULL, &bird);
+        if (frame.populationCount > 0) {
+            // cả đàn trong 1 lần SDL_RenderGeometry, màu/alpha từng chim qua màu đỉnh
+            for (int i = 0; i < frame.populationCount; i++)
+                batchSprite(birdBatch, BIRD_X, frame.populationY[i] * (1.0f / FIXED_ONE), BIRD_SIZE, BIRD_SIZE, flockColors[frame.populationId[i] % 32]);
+            frameCounters.drawCalls += flushSprites(renderer, birdTexture, birdBatch);
+        }
+        else {
+            SDL_RenderCopy(renderer, birdTexture, NULL, &frame.bird);
+            frameCounters.drawCalls++;
+        }
         SDL_Rect groundRect = {0, SCREEN_HEIGHT - 140, SCREEN_WIDTH, 140};
         SDL_RenderCopy(renderer, groundTexture, NULL, &groundRect);
+        frameCounters.drawCalls++;
+        if (frame.hitboxNote) {
+            SDL_Rect hitboxRect = {20, 20, 260, 20};
+            batchTextInRect(textBatch, textAtlas, hitboxRect, frame.hitboxNote, {255, 255, 255, 255});
+        }
+    }
+    renderScore(frame.score);
+    renderHighScore(frame.highScore);
+    frameCounters.drawCalls += flushBatch(renderer, textAtlas, textBatch);
+    frameCounters.drawCalls += endScene(renderer);
+    renderPerfHud(renderer);
+    {
+        PROFILE_ZONE("SDL_RenderPresent");
+        SDL_RenderPresent(renderer);
+    }
+}
+
+void publishSnapshot() {
+    FrameSnapshot& frame = frameBuffer.writeBuffer();
+    const SimState& shown = populationMode ? population.course : world;
+    frame.bird = {BIRD_X, world.birdY, BIRD_SIZE, BIRD_SIZE};
+    frame.pipeCount = shown.pipeCount;
+    for (int i = 0; i < frame.pipeCount; i++) frame.pipes[i] = shown.pipes[i];
+    frame.pipeWidth = populationMode || courseMode ? PIPE_WIDTH : SIM_VARIANT_RULES[gameVariant].pipeWidth;
+    frame.modeName = courseMode ? "course" : simVariantName(gameVariant);
+    frame.hitboxNote = nullptr;
+    if (pixelCollision && botMode == BOT_OFF && !populationMode) {
+        if (courseMode) frame.hitboxNote = "Course: box hitbox";
+        else if (rankedSeed) frame.hitboxNote = "Ranked seed: box hitbox";
+    }
+    frame.score = shown.score;
+    frame.populationCount = populationMode ? population.alive : 0;
+    for (int i = 0; i < frame.populationCount; i++) {
+        frame.populationY[i] = population.y[i];
+        frame.populationId[i] = population.id[i];
+    }
+    frame.highScore = highScore;
+    frame.showMenu = showMenu;
+    frame.showGameOverScreen = showGameOverScreen;
+    frameBuffer.publish();
+
+    // đổi màn hình thì báo thread chính, nó có thể đang chặn trong SDL_WaitEventTimeout
+    static bool lastMenu = true, lastGameOver = false;
+    if (showMenu != lastMenu || showGameOverScreen != lastGameOver) {
+        SDL_Event event = {};
+        event.type = simWakeEvent;
+        SDL_PushEvent(&event);
+    }
+    lastMenu = showMenu;
+    lastGameOver = showGameOverScreen;
+}
+
+// Chế độ tự chơi: bot quyết định nhảy, tự bắt đầu và chơi lại sau game over
+void attractTick() {
+    if (showGameOverScreen && ++attractWait < ATTRACT_RESTART_TICKS) return;
+    attractWait = 0;
+    bool jump;
+    if (courseMode) jump = courseDecide(course, world);// các bot khác chỉ biết luật gốc
+    else if (gameVariant != SIM_CLASSIC) jump = autopilotDecideRules(SIM_VARIANT_RULES[gameVariant], world);
+    else if (botMode == BOT_PLANNER) jump = planJump(planner, world);
+    else if (botMode == BOT_NEURAL) jump = nnDecide(policy, world);
+    else if (!dpDecide(world, jump)) jump = autopilotDecide(world);
+    if (showMenu || showGameOverScreen || jump) applyInput(INPUT_FLAP);
+}
+
+void updatePopulation() {
+    PROFILE_ZONE("updatePopulation");
+    stepPopulation(population, policyLoaded ? &policy : nullptr);// không có policy.nn thì cả đàn dùng autopilot
+    if (population.alive == 0) spawnPopulation(population, POPULATION_MAX, population.rng);// chết hết thì thả đàn mới, đường ống mới
+}
+
+// 1 tick mô phỏng: nhận input đã chuyển sang, update(), rồi gửi ảnh chụp cho thread vẽ
+void simTick() {
+    InputCommand command;
+    while (inputQueue.pop(command)) applyInput(command);
+    if (botMode != BOT_OFF && !populationMode) attractTick();
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    if (populationMode) updatePopulation();
+    else update();
+    metricObserve(METRIC_UPDATE_TIME, (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency());
+    metricSet(METRIC_PIPES_ALIVE, world.pipeCount);
+    metricSet(METRIC_SCORE, world.score);
+    metricSet(METRIC_HIGH_SCORE, highScore);
+
+    publishSnapshot();
+}
+
+// Thread mô phỏng chạy cố định SIM_HZ, độc lập với tốc độ vẽ
+void runSimulation() {
+    PROFILE_THREAD("sim");
+    Uint64 period = SDL_GetPerformanceFrequency() / SIM_HZ;
+    Uint64 next = SDL_GetPerformanceCounter();
+    while (isRunning) {
+        // màn hình menu/game over không có gì chuyển động: ngủ tới khi có input
+        if ((showMenu || showGameOverScreen) && botMode == BOT_OFF) {
+            Uint32 seen = inputSignal.load();
+            if (inputQueue.empty() && isRunning) {
+                inputSignal.wait(seen);
+                next = SDL_GetPerformanceCounter();
+                continue;
+            }
+        }
+        simTick();
+        next += period;
+        Uint64 now = SDL_GetPerformanceCounter();
+        if (next + period * MAX_SIM_STEPS < now) next = now;// trễ quá nhiều thì bỏ, không đuổi theo
+        sleepUntil(next);
     }
-    renderScore();
-    renderHighScore();
-    SDL_RenderPresent(renderer);
 }
 
 void cleanUp() {
+    logFrameStats();
+    if (wakeCount) cout << "Wake latency: " << wakeCount << " wakes, mean " << wakeSumMs / wakeCount << " ms, max " << wakeMaxMs << " ms" << endl;
+    finishGame();// thread mô phỏng đã dừng; ván đang ở màn hình game over vẫn được ghi
+    stopMetricsExporter();
+    stopFlightRecorder();
+    unloadDpTable();
+    unloadSeedIndex();
+    if (plannerReady) destroyPlanner(planner);
+    PROFILE_DUMP("trace.json");
+    destroyPerfHud();
+    destroyGlyphAtlas(textAtlas);
+    destroyDynamicResolution();
     SDL_DestroyTexture(background);
     SDL_DestroyTexture(birdTexture);
     SDL_DestroyTexture(pipeTexture);
@@ -261,21 +667,143 @@ void cleanUp() {
     Mix_FreeChunk(soundGameOver);
     Mix_CloseAudio();
     TTF_CloseFont(font);
+    TTF_CloseFont(hudFont);
     TTF_Quit();
     IMG_Quit();
     SDL_Quit();
 }
 
 
+// Bot cho chế độ kiểm tra: autopilot qua ALLOC_CHECK_SCORE + số ván đã chơi rồi thôi nhảy để chết,
+// nên mỗi ván có ghi điểm, bỏ ống ra khỏi màn hình, kỷ lục mới và game over
+const int ALLOC_CHECK_SCORE = 2;
+int allocCheckGames = 0;
+
+bool scriptedJump() {
+    if (showMenu || showGameOverScreen) return true;
+    if (world.gameOver || world.score >= ALLOC_CHECK_SCORE + allocCheckGames) return false;
+    bool jump;
+    if (gameVariant != SIM_CLASSIC) jump = autopilotDecideRules(SIM_VARIANT_RULES[gameVariant], world);
+    else if (!dpDecide(world, jump)) jump = autopilotDecide(world);
+    return jump;
+}
+
+// Chạy 10000 khung với input giả lập, thất bại nếu có khung nào cấp phát heap,
+// hoặc nếu bot không đi qua đủ đường nóng (ghi điểm, bỏ ống, game over).
+// Khung chuyển sang game over được miễn vì saveHighScore() ghi file.
+int runAllocCheck() {
+    const int FRAMES = 10000;
+    const int WARMUP = 120;// để SDL cấp phát hàng đợi sự kiện, bộ đệm lệnh vẽ
+    int allocFrames = 0, gameOverFrames = 0, scoredFrames = 0, evictFrames = 0;
+    Uint64 allocTotal = 0;
+
+    for (int frame = 0; frame < FRAMES && isRunning; frame++) {
+        if (scriptedJump()) {
+            SDL_Event event = {};
+            event.type = SDL_KEYDOWN;
+            event.key.keysym.sym = SDLK_SPACE;
+            SDL_PushEvent(&event);
+        }
+
+        bool wasGameOver = showGameOverScreen;
+        SimState before = world;
+        Uint64 allocsBefore = allocationCount();
+        handleInput();
+        simTick();
+        frameBuffer.update();
+        render(frameBuffer.readBuffer());
+        Uint64 allocs = allocationCount() - allocsBefore;
+
+        // cùng ván, tick kế tiếp: ống đầu lùi về phải nghĩa là ống cũ đã bị bỏ
+        bool sameGame = world.tick == before.tick + 1;
+        if (sameGame && world.score > before.score) scoredFrames++;
+        if (sameGame && before.pipeCount > 0 && world.pipeCount > 0 && world.pipes[0].x > before.pipes[0].x) evictFrames++;
+
+        if (frame < WARMUP) continue;
+        if (!wasGameOver && showGameOverScreen) {
+            gameOverFrames++;
+            allocCheckGames++;
+            continue;
+        }
+        if (allocs > 0) {
+            if (allocFrames < 10) cout << "frame " << frame << ": " << allocs << " allocations" << endl;
+            allocFrames++;
+            allocTotal += allocs;
+        }
+    }
+
+    cout << "alloc-check: " << FRAMES - WARMUP << " frames, " << allocFrames << " allocating frames, "
+         << allocTotal << " allocations, " << gameOverFrames << " game-over frames skipped, "
+         << scoredFrames << " scoring frames, " << evictFrames << " pipe evictions, high score " << highScore << endl;
+    if (scoredFrames == 0 || evictFrames == 0 || gameOverFrames == 0) {
+        cout << "alloc-check: scripted run never reached scoring, pipe eviction and game over" << endl;
+        return 1;
+    }
+    return allocFrames == 0 ? 0 : 1;
+}
+
 int main(int argc, char* argv[]) {
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--seed-band") == 0) sscanf(argv[i + 1], "%f:%f", &seedBandLo, &seedBandHi);
+        if (strcmp(argv[i], "--variant") == 0)
+            for (int v = 0; v < SIM_VARIANT_COUNT; v++)
+                if (strcmp(argv[i + 1], simVariantName((SimVariant)v)) == 0) gameVariant = (SimVariant)v;
+    }
     init();
 
+    if (argc > 1 && strcmp(argv[1], "--alloc-check") == 0) {
+        int result = runAllocCheck();
+        cleanUp();
+        return result;
+    }
+
+    publishSnapshot();// để khung đầu tiên đã có menu
+    thread simThread(runSimulation);
+    bool redraw = true;
     while (isRunning) {
-        handleInput();
-        update();
-        render();
-        SDL_Delay(16);
+        PROFILE_ZONE("frame");
+        const FrameSnapshot& shown = frameBuffer.readBuffer();
+        bool idle = (shown.showMenu || shown.showGameOverScreen) && !perfHudVisible();
+
+        // màn hình tĩnh: chặn chờ sự kiện thay vì vẽ lại 60 lần/giây
+        if (idle && !redraw) {
+            SDL_Event event;
+            if (SDL_WaitEventTimeout(&event, IDLE_WAIT_MS)) {
+                if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_SPACE && !wakeStart) {
+                    wakeStart = SDL_GetPerformanceCounter();
+                    wakeFromMenu = shown.showMenu;
+                    wakeFromGameOver = shown.showGameOverScreen;
+                }
+                redraw |= handleEvent(event);
+            }
+        }
+        redraw |= handleInput();
+        redraw |= frameBuffer.update();
+        if (idle && !redraw) continue;
+
+        if (idle) resumeFramePacer();
+        const FrameSnapshot& frame = frameBuffer.readBuffer();
+        render(frame);
+        redraw = false;
+
+        if (wakeStart && (frame.showMenu != wakeFromMenu || frame.showGameOverScreen != wakeFromGameOver)) {
+            double ms = (double)(SDL_GetPerformanceCounter() - wakeStart) * 1000.0 / SDL_GetPerformanceFrequency();
+            wakeCount++;
+            wakeSumMs += ms;
+            if (ms > wakeMaxMs) wakeMaxMs = ms;
+            metricObserve(METRIC_WAKE_LATENCY, ms / 1000);
+            wakeStart = 0;
+        }// đo độ trễ từ phím bấm tới khung đầu tiên phản ánh nó
+        {
+            PROFILE_ZONE("waitNextFrame");
+            waitNextFrame();
+        }
+        perfHudEndFrame(frameStats().lastFrameMs, frameStats().targetMs);
+        dynamicResolutionFrame(frameStats().lastFrameMs, frameStats().targetMs);
+        metricAdd(METRIC_FRAMES);
+        metricObserve(METRIC_FRAME_TIME, frameStats().lastFrameMs / 1000);
     }
+    simThread.join();
     cleanUp();
     return 0;
 }
\ No newline at end of file
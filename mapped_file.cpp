@@ -0,0 +1,66 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool mapFile(MappedFile& file, const char* path) {
+    unmapFile(file);
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0) {
+        CloseHandle(handle);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(handle);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(handle);
+        return false;
+    }
+    file.data = (const uint8_t*)view;
+    file.size = (size_t)size.QuadPart;
+    file.file = handle;
+    file.mapping = mapping;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);// mapping vẫn giữ file
+    if (view == MAP_FAILED) return false;
+    file.data = (const uint8_t*)view;
+    file.size = st.st_size;
+#endif
+    return true;
+}
+
+void unmapFile(MappedFile& file) {
+    if (!file.data) return;
+#ifdef _WIN32
+    UnmapViewOfFile(file.data);
+    CloseHandle(file.mapping);
+    CloseHandle(file.file);
+    file.file = file.mapping = nullptr;
+#else
+    munmap((void*)file.data, file.size);
+#endif
+    file.data = nullptr;
+    file.size = 0;
+}
@@ -0,0 +1,20 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// File chỉ đọc được ánh xạ vào bộ nhớ; hệ điều hành nạp trang khi cần, không copy cả file
+struct MappedFile {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* file = nullptr;       // HANDLE, để void* cho khỏi include windows.h ở header
+    void* mapping = nullptr;
+#endif
+};
+
+bool mapFile(MappedFile& file, const char* path);
+void unmapFile(MappedFile& file);
+
+#endif
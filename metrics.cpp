@@ -0,0 +1,194 @@
+#include "metrics.h"
+#include <SDL2/SDL_mixer.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+using namespace std;
+
+const int METRIC_MAX_BUCKETS = 12;
+
+struct HistogramSpec {
+    const char* name;
+    const char* help;
+    int bucketCount;
+    double bounds[METRIC_MAX_BUCKETS];
+};
+
+static const HistogramSpec histogramSpecs[METRIC_HISTOGRAM_COUNT] = {
+    {"flappy_frame_time_seconds", "Wall time between presented frames.", 10,
+     {0.004, 0.008, 0.012, 0.016, 0.017, 0.020, 0.025, 0.033, 0.050, 0.100}},
+    {"flappy_update_duration_seconds", "Time spent in one update() step.", 8,
+     {0.000005, 0.00001, 0.000025, 0.00005, 0.0001, 0.00025, 0.0005, 0.001}},
+    {"flappy_game_score", "Final score of each finished game.", 9,
+     {0, 1, 2, 5, 10, 20, 50, 100, 200}},
+    {"flappy_wake_latency_seconds", "Keypress on an idle screen to the first presented frame that reflects it.", 8,
+     {0.002, 0.005, 0.010, 0.017, 0.025, 0.033, 0.050, 0.100}},
+};
+
+static const char* counterNames[METRIC_COUNTER_COUNT][2] = {
+    {"flappy_frames_total", "Frames presented."},
+    {"flappy_games_played_total", "Games that reached game over."},
+    {"flappy_audio_underruns_total", "Audio mix callbacks that arrived late enough to starve the device."},
+};
+
+static const char* gaugeNames[METRIC_GAUGE_COUNT][2] = {
+    {"flappy_pipes_alive", "Pipes currently in the world."},
+    {"flappy_score", "Score of the current game."},
+    {"flappy_high_score", "Best score recorded."},
+};
+
+// Mỗi thread 1 shard, chỉ thread đó ghi nên dùng load/store relaxed là đủ
+struct MetricShard {
+    atomic<Uint64> counters[METRIC_COUNTER_COUNT] = {};
+    atomic<Uint64> buckets[METRIC_HISTOGRAM_COUNT][METRIC_MAX_BUCKETS + 1] = {};
+    atomic<Uint64> counts[METRIC_HISTOGRAM_COUNT] = {};
+    atomic<double> sums[METRIC_HISTOGRAM_COUNT] = {};
+};
+
+static mutex shardMutex;
+static vector<MetricShard*> shards;
+static thread_local MetricShard* localShard = nullptr;
+static atomic<double> gauges[METRIC_GAUGE_COUNT] = {};
+
+static MetricShard* threadShard() {
+    if (!localShard) {
+        localShard = new MetricShard();
+        lock_guard<mutex> lock(shardMutex);
+        shards.push_back(localShard);
+    }
+    return localShard;
+}
+
+void metricAdd(MetricCounter counter, Uint64 n) {
+    atomic<Uint64>& c = threadShard()->counters[counter];
+    c.store(c.load(memory_order_relaxed) + n, memory_order_relaxed);
+}
+
+void metricSet(MetricGauge gauge, double value) {
+    gauges[gauge].store(value, memory_order_relaxed);
+}
+
+void metricObserve(MetricHistogram histogram, double value) {
+    MetricShard* shard = threadShard();
+    const HistogramSpec& spec = histogramSpecs[histogram];
+    int b = 0;
+    while (b < spec.bucketCount && value > spec.bounds[b]) b++;
+
+    atomic<Uint64>& bucket = shard->buckets[histogram][b];
+    bucket.store(bucket.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    atomic<Uint64>& count = shard->counts[histogram];
+    count.store(count.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    atomic<double>& sum = shard->sums[histogram];
+    sum.store(sum.load(memory_order_relaxed) + value, memory_order_relaxed);
+}
+
+// Gộp tất cả shard và định dạng vào bộ đệm cố định, trả về số byte
+static int formatMetrics(char* out, int capacity) {
+    Uint64 counters[METRIC_COUNTER_COUNT] = {};
+    Uint64 buckets[METRIC_HISTOGRAM_COUNT][METRIC_MAX_BUCKETS + 1] = {};
+    Uint64 counts[METRIC_HISTOGRAM_COUNT] = {};
+    double sums[METRIC_HISTOGRAM_COUNT] = {};
+    {
+        lock_guard<mutex> lock(shardMutex);
+        for (MetricShard* shard : shards) {
+            for (int i = 0; i < METRIC_COUNTER_COUNT; i++) counters[i] += shard->counters[i].load(memory_order_relaxed);
+            for (int h = 0; h < METRIC_HISTOGRAM_COUNT; h++) {
+                for (int b = 0; b <= METRIC_MAX_BUCKETS; b++) buckets[h][b] += shard->buckets[h][b].load(memory_order_relaxed);
+                counts[h] += shard->counts[h].load(memory_order_relaxed);
+                sums[h] += shard->sums[h].load(memory_order_relaxed);
+            }
+        }
+    }
+
+    int n = 0;
+    auto put = [&](const char* fmt, auto... args) {
+        if (n < capacity) n += snprintf(out + n, capacity - n, fmt, args...);
+    };
+    for (int i = 0; i < METRIC_COUNTER_COUNT; i++) {
+        put("# HELP %s %s\n# TYPE %s counter\n%s %llu\n", counterNames[i][0], counterNames[i][1],
+            counterNames[i][0], counterNames[i][0], (unsigned long long)counters[i]);
+    }
+    for (int i = 0; i < METRIC_GAUGE_COUNT; i++) {
+        put("# HELP %s %s\n# TYPE %s gauge\n%s %g\n", gaugeNames[i][0], gaugeNames[i][1],
+            gaugeNames[i][0], gaugeNames[i][0], gauges[i].load(memory_order_relaxed));
+    }
+    for (int h = 0; h < METRIC_HISTOGRAM_COUNT; h++) {
+        const HistogramSpec& spec = histogramSpecs[h];
+        put("# HELP %s %s\n# TYPE %s histogram\n", spec.name, spec.help, spec.name);
+        Uint64 cumulative = 0;
+        for (int b = 0; b < spec.bucketCount; b++) {
+            cumulative += buckets[h][b];
+            put("%s_bucket{le=\"%g\"} %llu\n", spec.name, spec.bounds[b], (unsigned long long)cumulative);
+        }
+        put("%s_bucket{le=\"+Inf\"} %llu\n", spec.name, (unsigned long long)counts[h]);
+        put("%s_sum %g\n%s_count %llu\n", spec.name, sums[h], spec.name, (unsigned long long)counts[h]);
+    }
+    return n < capacity ? n : capacity;
+}
+
+static bool replaceFile(const char* from, const char* to) {
+#ifdef _WIN32
+    return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(from, to) == 0;
+#endif
+}
+
+static void writeMetricsFile(const char* path) {
+    static char text[16384];
+    static char tmpPath[512];
+    int length = formatMetrics(text, sizeof(text));
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+
+    FILE* file = fopen(tmpPath, "wb");
+    if (!file) return;
+    bool ok = fwrite(text, 1, length, file) == (size_t)length;
+    ok = fclose(file) == 0 && ok;
+    if (ok) replaceFile(tmpPath, path);
+}
+
+static thread exporterThread;
+static mutex exporterMutex;
+static condition_variable exporterWake;
+static bool exporterStop = false;
+
+void startMetricsExporter(const char* path, int intervalMs) {
+    exporterStop = false;
+    exporterThread = thread([path, intervalMs]() {
+        unique_lock<mutex> lock(exporterMutex);
+        while (!exporterStop) {
+            exporterWake.wait_for(lock, chrono::milliseconds(intervalMs));
+            writeMetricsFile(path);
+        }
+    });
+}
+
+void stopMetricsExporter() {
+    if (!exporterThread.joinable()) return;
+    {
+        lock_guard<mutex> lock(exporterMutex);
+        exporterStop = true;
+    }
+    exporterWake.notify_one();
+    exporterThread.join();
+}
+
+static Uint64 lastMixCall = 0;
+static Uint64 underrunTicks = 0;
+
+static void underrunProbe(void*, Uint8*, int) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (lastMixCall && now - lastMixCall > underrunTicks) metricAdd(METRIC_AUDIO_UNDERRUNS);
+    lastMixCall = now;
+}
+
+void installAudioUnderrunProbe(int frequency, int chunkSamples) {
+    underrunTicks = SDL_GetPerformanceFrequency() * chunkSamples * 3 / (2 * (Uint64)frequency);
+    Mix_SetPostMix(underrunProbe, nullptr);
+}
@@ -0,0 +1,40 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <SDL2/SDL.h>
+
+enum MetricCounter {
+    METRIC_FRAMES,
+    METRIC_GAMES_PLAYED,
+    METRIC_AUDIO_UNDERRUNS,
+    METRIC_COUNTER_COUNT
+};
+
+enum MetricGauge {
+    METRIC_PIPES_ALIVE,
+    METRIC_SCORE,
+    METRIC_HIGH_SCORE,
+    METRIC_GAUGE_COUNT
+};
+
+enum MetricHistogram {
+    METRIC_FRAME_TIME,      // giây
+    METRIC_UPDATE_TIME,     // giây
+    METRIC_GAME_SCORE,      // điểm cuối mỗi ván
+    METRIC_WAKE_LATENCY,    // giây, từ lúc bấm phím ở màn hình chờ tới khi khung mới được present
+    METRIC_HISTOGRAM_COUNT
+};
+
+// Ghi chỉ chạm vào shard của thread hiện tại, không khoá, không cấp phát sau lần đầu
+void metricAdd(MetricCounter counter, Uint64 n = 1);
+void metricSet(MetricGauge gauge, double value);
+void metricObserve(MetricHistogram histogram, double value);
+
+// Thread nền gộp các shard và ghi file định dạng Prometheus text (ghi file tạm rồi rename)
+void startMetricsExporter(const char* path, int intervalMs);
+void stopMetricsExporter();
+
+// Đếm underrun: post-mix callback đến trễ hơn 1.5 lần độ dài 1 chunk
+void installAudioUnderrunProbe(int frequency, int chunkSamples);
+
+#endif
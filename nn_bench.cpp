@@ -0,0 +1,70 @@
+#include "nn_policy.h"
+#include "autopilot.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+
+// Đo chi phí 1 lần gọi policy cho mỗi chim, theo từng kernel, trên trạng thái lấy từ ván thật.
+// Không có file policy thì dùng mạng 5-16-16-1 trọng số ngẫu nhiên (chỉ đo tốc độ).
+const int BIRDS = 16384;
+const int REPEAT = 200;
+
+static void randomModel(NnModel& model, uint32_t seed) {
+    const int dims[] = {NN_INPUTS, 16, 16, 1};
+    initNnModel(model, dims, 3);
+    for (int l = 0; l < model.layerCount; l++) {
+        NnLayer& layer = model.layers[l];
+        float range = 1 / sqrtf((float)layer.in);
+        for (float& w : layer.weights) w = range * ((int)(simRandom(seed) % 2001) - 1000) / 1000.0f;
+        for (float& b : layer.bias) b = 0.1f * ((int)(simRandom(seed) % 2001) - 1000) / 1000.0f;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    NnModel model;
+    const char* path = argc > 1 ? argv[1] : nullptr;
+    if (path && !loadNnModel(model, path)) {
+        printf("cannot load %s\n", path);
+        return 1;
+    }
+    if (!path) randomModel(model, 12345);
+
+    // trạng thái thật: autopilot chơi nhiều seed
+    vector<SimState> states;
+    states.reserve(BIRDS);
+    for (uint32_t seed = 1; (int)states.size() < BIRDS; seed++) {
+        SimState s;
+        simSeed(s, seed);
+        while (!s.gameOver && (int)states.size() < BIRDS && s.tick < 2000) {
+            states.push_back(s);
+            simStep(s, autopilotDecide(s));
+        }
+    }
+    vector<float> soa(NN_INPUTS * BIRDS);
+    nnGatherFeatures(states.data(), BIRDS, soa.data(), BIRDS);
+    if (!path) calibrateNnModel(model, soa.data(), BIRDS, BIRDS);
+
+    printf("%d birds, %d layers:", BIRDS, model.layerCount);
+    for (int l = 0; l < model.layerCount; l++) printf(" %d", model.layers[l].in);
+    printf(" 1\n%-14s %12s %14s %12s\n", "kernel", "ns/bird", "Mbirds/s", "agree");
+
+    vector<uint8_t> reference(BIRDS), jump(BIRDS);
+    nnEvaluate(model, NN_FLOAT_SCALAR, soa.data(), BIRDS, BIRDS, reference.data());
+    for (NnKernel kernel : {NN_FLOAT_SCALAR, NN_FLOAT_AVX2, NN_INT8_SCALAR, NN_INT8_AVX2}) {
+        if (!nnKernelSupported(kernel)) {
+            printf("%-14s %12s\n", nnKernelName(kernel), "unsupported");
+            continue;
+        }
+        auto start = chrono::steady_clock::now();
+        for (int r = 0; r < REPEAT; r++) nnEvaluate(model, kernel, soa.data(), BIRDS, BIRDS, jump.data());
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / ((double)BIRDS * REPEAT);
+
+        int agree = 0;
+        for (int b = 0; b < BIRDS; b++) agree += jump[b] == reference[b];
+        printf("%-14s %12.2f %14.1f %11.2f%%\n", nnKernelName(kernel), ns, 1e3 / ns, 100.0 * agree / BIRDS);
+    }
+    return 0;
+}
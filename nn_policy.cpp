@@ -0,0 +1,347 @@
+#include "nn_policy.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NN_HAVE_AVX2 1
+#include <immintrin.h>
+#endif
+using namespace std;
+
+struct NnHeader {
+    char magic[4];          // "FLNN"
+    uint16_t version;
+    uint16_t layerCount;
+    uint16_t dims[NN_MAX_LAYERS + 1];
+    uint16_t reserved;
+};
+
+bool initNnModel(NnModel& model, const int* dims, int layerCount) {
+    if (layerCount < 1 || layerCount > NN_MAX_LAYERS || dims[0] != NN_INPUTS || dims[layerCount] != 1) return false;
+    for (int l = 0; l <= layerCount; l++) {
+        if (dims[l] < 1 || dims[l] > NN_MAX_WIDTH) return false;
+    }
+    model.layerCount = layerCount;
+    for (int l = 0; l < layerCount; l++) {
+        NnLayer& layer = model.layers[l];
+        layer.in = dims[l];
+        layer.out = dims[l + 1];
+        layer.weights.assign(layer.in * layer.out, 0.0f);
+        layer.bias.assign(layer.out, 0.0f);
+        layer.inMax = 1;
+    }
+    quantizeNnModel(model);
+    return true;
+}
+
+void quantizeNnModel(NnModel& model) {
+    for (int l = 0; l < model.layerCount; l++) {
+        NnLayer& layer = model.layers[l];
+        layer.inPairs = (layer.in + 1) / 2;
+        layer.qweights.assign(layer.out * layer.inPairs * 2, 0);
+        layer.qscale.assign(layer.out, 0.0f);
+        for (int j = 0; j < layer.out; j++) {
+            const float* row = &layer.weights[j * layer.in];
+            float rowMax = 0;
+            for (int i = 0; i < layer.in; i++) rowMax = max(rowMax, fabsf(row[i]));
+            float scale = rowMax > 0 ? rowMax / 127 : 1;// đối xứng, theo từng hàng
+            for (int i = 0; i < layer.in; i++) layer.qweights[j * layer.inPairs * 2 + i] = (int16_t)lrintf(row[i] / scale);
+            layer.qscale[j] = scale * layer.inMax / 127;
+        }
+    }
+}
+
+static int16_t quantize(float x, float scale) {
+    long q = lrintf(x * scale);
+    return (int16_t)(q > 127 ? 127 : q < -127 ? -127 : q);
+}
+
+// ---- float, scalar ----
+// maxIn != nullptr thì ghi lại |đầu vào| lớn nhất của từng lớp (hiệu chỉnh int8)
+static void forwardFloatScalar(const NnModel& model, const float* soa, int stride, int base, float* out, float* maxIn) {
+    float bufA[NN_MAX_WIDTH][NN_BLOCK], bufB[NN_MAX_WIDTH][NN_BLOCK];
+    for (int i = 0; i < NN_INPUTS; i++)
+        for (int b = 0; b < NN_BLOCK; b++) bufA[i][b] = soa[i * stride + base + b];
+
+    float (*x)[NN_BLOCK] = bufA;
+    float (*y)[NN_BLOCK] = bufB;
+    for (int l = 0; l < model.layerCount; l++) {
+        const NnLayer& layer = model.layers[l];
+        bool hidden = l + 1 < model.layerCount;
+        if (maxIn) {
+            for (int i = 0; i < layer.in; i++)
+                for (int b = 0; b < NN_BLOCK; b++) maxIn[l] = max(maxIn[l], fabsf(x[i][b]));
+        }
+        for (int j = 0; j < layer.out; j++) {
+            const float* row = &layer.weights[j * layer.in];
+            float acc[NN_BLOCK];
+            for (int b = 0; b < NN_BLOCK; b++) acc[b] = layer.bias[j];
+            for (int i = 0; i < layer.in; i++)
+                for (int b = 0; b < NN_BLOCK; b++) acc[b] += row[i] * x[i][b];
+            for (int b = 0; b < NN_BLOCK; b++) y[j][b] = hidden && acc[b] < 0 ? 0 : acc[b];
+        }
+        swap(x, y);
+    }
+    for (int b = 0; b < NN_BLOCK; b++) out[b] = x[0][b];
+}
+
+// ---- int8, scalar ----
+// Kích hoạt lưu như bản float: q[i][b] = đầu vào i của chim b, chim ở vòng trong cùng
+static void forwardInt8Scalar(const NnModel& model, const float* soa, int stride, int base, float* out) {
+    int16_t bufA[NN_MAX_WIDTH][NN_BLOCK], bufB[NN_MAX_WIDTH][NN_BLOCK];
+    const NnLayer& first = model.layers[0];
+    float inScale = 127 / first.inMax;
+    for (int i = 0; i < NN_INPUTS; i++)
+        for (int b = 0; b < NN_BLOCK; b++) bufA[i][b] = quantize(soa[i * stride + base + b], inScale);
+
+    int16_t (*x)[NN_BLOCK] = bufA;
+    int16_t (*y)[NN_BLOCK] = bufB;
+    for (int l = 0; l < model.layerCount; l++) {
+        const NnLayer& layer = model.layers[l];
+        bool hidden = l + 1 < model.layerCount;
+        float nextScale = hidden ? 127 / model.layers[l + 1].inMax : 0;
+        for (int j = 0; j < layer.out; j++) {
+            // qweights theo hàng [out][inPairs * 2], phần đệm cuối hàng không cần đọc
+            const int16_t* row = &layer.qweights[j * layer.inPairs * 2];
+            int32_t acc[NN_BLOCK] = {};
+            for (int i = 0; i < layer.in; i++)
+                for (int b = 0; b < NN_BLOCK; b++) acc[b] += x[i][b] * row[i];
+            if (!hidden) {
+                for (int b = 0; b < NN_BLOCK; b++) out[b] = acc[b] * layer.qscale[0] + layer.bias[0];
+                return;
+            }
+            // Lượng tử lại: gộp qscale và nextScale, kẹp 127 rồi ReLU trên số nguyên (không rẽ nhánh theo dữ liệu)
+            float mul = layer.qscale[j] * nextScale, add = layer.bias[j] * nextScale;
+            for (int b = 0; b < NN_BLOCK; b++) {
+                float v = acc[b] * mul + add;
+                int q = (int)((v < 127 ? v : 127) + 0.5f);
+                y[j][b] = (int16_t)(q > 0 ? q : 0);
+            }
+        }
+        swap(x, y);
+    }
+}
+
+#ifdef NN_HAVE_AVX2
+// N đầu ra cùng lúc: N chuỗi FMA độc lập, không phải chờ độ trễ của từng chuỗi
+template <int N>
+__attribute__((target("avx2,fma")))
+static inline void denseFloatAvx2(const NnLayer& layer, int j, const __m256* x, __m256* y, bool hidden) {
+    __m256 acc[N];
+    for (int k = 0; k < N; k++) acc[k] = _mm256_set1_ps(layer.bias[j + k]);
+    const float* row = &layer.weights[j * layer.in];
+    for (int i = 0; i < layer.in; i++) {
+        for (int k = 0; k < N; k++) acc[k] = _mm256_fmadd_ps(_mm256_set1_ps(row[k * layer.in + i]), x[i], acc[k]);
+    }
+    for (int k = 0; k < N; k++) y[j + k] = hidden ? _mm256_max_ps(acc[k], _mm256_setzero_ps()) : acc[k];
+}
+
+__attribute__((target("avx2,fma")))
+static void forwardFloatAvx2(const NnModel& model, const float* soa, int stride, int base, float* out) {
+    __m256 bufA[NN_MAX_WIDTH], bufB[NN_MAX_WIDTH];
+    for (int i = 0; i < NN_INPUTS; i++) bufA[i] = _mm256_loadu_ps(soa + i * stride + base);
+
+    __m256* x = bufA;
+    __m256* y = bufB;
+    for (int l = 0; l < model.layerCount; l++) {
+        const NnLayer& layer = model.layers[l];
+        bool hidden = l + 1 < model.layerCount;
+        int j = 0;
+        for (; j + 8 <= layer.out; j += 8) denseFloatAvx2<8>(layer, j, x, y, hidden);
+        for (; j < layer.out; j++) denseFloatAvx2<1>(layer, j, x, y, hidden);
+        swap(x, y);
+    }
+    _mm256_storeu_ps(out, x[0]);
+}
+
+// Hai kích hoạt int32 (đã kẹp trong [-127, 127]) ghép thành 8 cặp int16 xen kẽ
+__attribute__((target("avx2,fma")))
+static inline __m256i packPair(__m256i lo, __m256i hi) {
+    return _mm256_or_si256(_mm256_and_si256(lo, _mm256_set1_epi32(0xFFFF)), _mm256_slli_epi32(hi, 16));
+}
+
+// N đầu ra (N chẵn hoặc 1): tích int8 qua madd, đổi về float, rồi lượng tử lại cho lớp sau
+template <int N>
+__attribute__((target("avx2,fma")))
+static inline void denseInt8Avx2(const NnLayer& layer, int j, const __m256i* x, __m256i* y, __m256 nextScale, float* out) {
+    __m256i acc[N];
+    for (int k = 0; k < N; k++) acc[k] = _mm256_setzero_si256();
+    const int16_t* row = &layer.qweights[j * layer.inPairs * 2];
+    for (int p = 0; p < layer.inPairs; p++) {
+        for (int k = 0; k < N; k++) {
+            int32_t weightPair;
+            memcpy(&weightPair, row + k * layer.inPairs * 2 + 2 * p, sizeof(weightPair));
+            acc[k] = _mm256_add_epi32(acc[k], _mm256_madd_epi16(x[p], _mm256_set1_epi32(weightPair)));
+        }
+    }
+    __m256i q[N];
+    for (int k = 0; k < N; k++) {
+        __m256 value = _mm256_fmadd_ps(_mm256_cvtepi32_ps(acc[k]), _mm256_set1_ps(layer.qscale[j + k]), _mm256_set1_ps(layer.bias[j + k]));
+        if (out) {
+            _mm256_storeu_ps(out, value);
+            return;
+        }
+        value = _mm256_max_ps(value, _mm256_setzero_ps());
+        q[k] = _mm256_min_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(value, nextScale)), _mm256_set1_epi32(127));
+    }
+    if (N == 1) y[j >> 1] = packPair(q[0], _mm256_setzero_si256());// chỉ dùng cho đầu ra lẻ cuối cùng
+    for (int k = 0; k + 1 < N; k += 2) y[(j + k) >> 1] = packPair(q[k], q[k + 1]);
+}
+
+__attribute__((target("avx2,fma")))
+static void forwardInt8Avx2(const NnModel& model, const float* soa, int stride, int base, float* out) {
+    __m256i bufA[NN_MAX_WIDTH / 2], bufB[NN_MAX_WIDTH / 2];
+    const NnLayer& first = model.layers[0];
+    __m256 inScale = _mm256_set1_ps(127 / first.inMax);
+    __m256i qmax = _mm256_set1_epi32(127), qmin = _mm256_set1_epi32(-127);
+    for (int p = 0; p < first.inPairs; p++) {
+        __m256i q[2];
+        for (int k = 0; k < 2; k++) {
+            int i = 2 * p + k;
+            if (i >= NN_INPUTS) {
+                q[k] = _mm256_setzero_si256();
+                continue;
+            }
+            __m256i v = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(soa + i * stride + base), inScale));
+            q[k] = _mm256_max_epi32(_mm256_min_epi32(v, qmax), qmin);
+        }
+        bufA[p] = packPair(q[0], q[1]);
+    }
+
+    __m256i* x = bufA;
+    __m256i* y = bufB;
+    for (int l = 0; l < model.layerCount; l++) {
+        const NnLayer& layer = model.layers[l];
+        if (l + 1 == model.layerCount) {
+            denseInt8Avx2<1>(layer, 0, x, y, _mm256_setzero_ps(), out);
+            return;
+        }
+        __m256 nextScale = _mm256_set1_ps(127 / model.layers[l + 1].inMax);
+        int j = 0;
+        for (; j + 8 <= layer.out; j += 8) denseInt8Avx2<8>(layer, j, x, y, nextScale, nullptr);
+        for (; j + 2 <= layer.out; j += 2) denseInt8Avx2<2>(layer, j, x, y, nextScale, nullptr);
+        if (j < layer.out) denseInt8Avx2<1>(layer, j, x, y, nextScale, nullptr);
+        swap(x, y);
+    }
+}
+#endif
+
+bool nnKernelSupported(NnKernel kernel) {
+    if (kernel == NN_FLOAT_SCALAR || kernel == NN_INT8_SCALAR) return true;
+#ifdef NN_HAVE_AVX2
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+    return false;
+#endif
+}
+
+const char* nnKernelName(NnKernel kernel) {
+    switch (kernel) {
+        case NN_FLOAT_SCALAR: return "float-scalar";
+        case NN_FLOAT_AVX2: return "float-avx2";
+        case NN_INT8_SCALAR: return "int8-scalar";
+        case NN_INT8_AVX2: return "int8-avx2";
+    }
+    return "?";
+}
+
+void nnEvaluate(const NnModel& model, NnKernel kernel, const float* soa, int stride, int count, uint8_t* jump) {
+    if (!nnKernelSupported(kernel)) kernel = NN_FLOAT_SCALAR;
+    float out[NN_BLOCK];
+    for (int base = 0; base < count; base += NN_BLOCK) {
+        switch (kernel) {
+#ifdef NN_HAVE_AVX2
+            case NN_FLOAT_AVX2: forwardFloatAvx2(model, soa, stride, base, out); break;
+            case NN_INT8_AVX2: forwardInt8Avx2(model, soa, stride, base, out); break;
+#endif
+            case NN_INT8_SCALAR: forwardInt8Scalar(model, soa, stride, base, out); break;
+            default: forwardFloatScalar(model, soa, stride, base, out, nullptr); break;
+        }
+        int n = min(NN_BLOCK, count - base);
+        for (int b = 0; b < n; b++) jump[base + b] = out[b] > 0;
+    }
+}
+
+void calibrateNnModel(NnModel& model, const float* soa, int stride, int count) {
+    float maxIn[NN_MAX_LAYERS] = {};
+    float out[NN_BLOCK];
+    for (int base = 0; base + NN_BLOCK <= count; base += NN_BLOCK) forwardFloatScalar(model, soa, stride, base, out, maxIn);
+    for (int l = 0; l < model.layerCount; l++) model.layers[l].inMax = maxIn[l] > 0 ? maxIn[l] : 1;
+    quantizeNnModel(model);
+}
+
+// Ống chưa qua đầu tiên và ống sau nó; khoảng cách chuẩn hoá về cỡ [-1, 1]
+void nnFeatures(const SimState& s, float* features) {
+    int next = 0;
+    while (next < s.pipeCount && s.pipes[next].x + PIPE_WIDTH <= BIRD_X + COLLISION_OFFSET) next++;
+    float center = s.birdY + BIRD_SIZE / 2;
+    features[0] = (float)s.birdY / SCREEN_HEIGHT;
+    features[1] = s.birdVelocity / 16.0f;
+    features[2] = next < s.pipeCount ? (float)(s.pipes[next].x - BIRD_X) / SCREEN_WIDTH : 1;
+    features[3] = next < s.pipeCount ? (s.pipes[next].height + s.pipes[next].gap / 2 - center) / SCREEN_HEIGHT : 0;
+    features[4] = next + 1 < s.pipeCount ? (s.pipes[next + 1].height + s.pipes[next + 1].gap / 2 - center) / SCREEN_HEIGHT : features[3];
+}
+
+void nnGatherFeatures(const SimState* states, int count, float* soa, int stride) {
+    float features[NN_INPUTS];
+    for (int b = 0; b < count; b++) {
+        nnFeatures(states[b], features);
+        for (int i = 0; i < NN_INPUTS; i++) soa[i * stride + b] = features[i];
+    }
+}
+
+bool nnDecide(const NnModel& model, const SimState& s) {
+    float soa[NN_INPUTS * NN_BLOCK] = {};
+    uint8_t jump[1];
+    nnGatherFeatures(&s, 1, soa, NN_BLOCK);
+    nnEvaluate(model, NN_FLOAT_SCALAR, soa, NN_BLOCK, 1, jump);
+    return jump[0];
+}
+
+bool loadNnModel(NnModel& model, const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    NnHeader header;
+    int dims[NN_MAX_LAYERS + 1] = {};
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 && memcmp(header.magic, "FLNN", 4) == 0
+              && header.version == 1 && header.layerCount >= 1 && header.layerCount <= NN_MAX_LAYERS;
+    if (ok) {
+        for (int l = 0; l <= header.layerCount; l++) dims[l] = header.dims[l];
+        ok = initNnModel(model, dims, header.layerCount);
+    }
+    for (int l = 0; ok && l < model.layerCount; l++) ok = fread(&model.layers[l].inMax, sizeof(float), 1, file) == 1;
+    for (int l = 0; ok && l < model.layerCount; l++) {
+        NnLayer& layer = model.layers[l];
+        ok = fread(layer.weights.data(), sizeof(float), layer.weights.size(), file) == layer.weights.size()
+             && fread(layer.bias.data(), sizeof(float), layer.bias.size(), file) == layer.bias.size();
+    }
+    fclose(file);
+    if (!ok) {
+        model.layerCount = 0;
+        return false;
+    }
+    quantizeNnModel(model);
+    return true;
+}
+
+bool saveNnModel(const NnModel& model, const char* path) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    NnHeader header = {};
+    memcpy(header.magic, "FLNN", 4);
+    header.version = 1;
+    header.layerCount = model.layerCount;
+    for (int l = 0; l < model.layerCount; l++) header.dims[l] = model.layers[l].in;
+    header.dims[model.layerCount] = model.layers[model.layerCount - 1].out;
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (int l = 0; ok && l < model.layerCount; l++) ok = fwrite(&model.layers[l].inMax, sizeof(float), 1, file) == 1;
+    for (int l = 0; ok && l < model.layerCount; l++) {
+        const NnLayer& layer = model.layers[l];
+        ok = fwrite(layer.weights.data(), sizeof(float), layer.weights.size(), file) == layer.weights.size()
+             && fwrite(layer.bias.data(), sizeof(float), layer.bias.size(), file) == layer.bias.size();
+    }
+    ok &= fclose(file) == 0;
+    return ok;
+}
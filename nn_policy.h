@@ -0,0 +1,61 @@
+#ifndef NN_POLICY_H
+#define NN_POLICY_H
+
+#include "sim.h"
+#include <cstdint>
+#include <vector>
+
+// Mạng MLP nhỏ điều khiển chim: NN_INPUTS đặc trưng -> các lớp ẩn ReLU -> 1 đầu ra, > 0 thì nhảy.
+// Đánh giá theo lô: đặc trưng xếp SoA (feature i của chim b ở soa[i * stride + b]),
+// mỗi lần xử lý NN_BLOCK chim để 1 vector AVX2 ứng với 8 chim.
+const int NN_INPUTS = 5;
+const int NN_MAX_LAYERS = 4;
+const int NN_MAX_WIDTH = 64;
+const int NN_BLOCK = 8;
+
+struct NnLayer {
+    int in = 0, out = 0;
+    std::vector<float> weights;         // [out][in]
+    std::vector<float> bias;
+    float inMax = 1;                    // |đầu vào| lớn nhất, quy ra thang int8 của lớp này
+
+    // bản lượng tử: trọng số int8 (lưu int16 thành cặp để dùng madd), thang theo từng hàng
+    int inPairs = 0;
+    std::vector<int16_t> qweights;      // [out][inPairs * 2], phần đệm = 0
+    std::vector<float> qscale;          // scale trọng số hàng * scale đầu vào
+};
+
+struct NnModel {
+    int layerCount = 0;
+    NnLayer layers[NN_MAX_LAYERS];
+};
+
+enum NnKernel {
+    NN_FLOAT_SCALAR,
+    NN_FLOAT_AVX2,
+    NN_INT8_SCALAR,
+    NN_INT8_AVX2,
+};
+
+// dims[0] = NN_INPUTS, dims[layerCount] = 1
+bool initNnModel(NnModel& model, const int* dims, int layerCount);
+void quantizeNnModel(NnModel& model);   // gọi lại sau khi đổi trọng số hoặc inMax
+// Đo biên độ thật của từng lớp trên các trạng thái mẫu để chọn thang int8
+void calibrateNnModel(NnModel& model, const float* soa, int stride, int count);
+
+// File "FLNN": header, inMax từng lớp, rồi trọng số + bias float từng lớp
+bool loadNnModel(NnModel& model, const char* path);
+bool saveNnModel(const NnModel& model, const char* path);
+
+void nnFeatures(const SimState& s, float* features);
+void nnGatherFeatures(const SimState* states, int count, float* soa, int stride);
+
+bool nnKernelSupported(NnKernel kernel);
+const char* nnKernelName(NnKernel kernel);
+// jump[b] = 1 nếu chim b nên nhảy; stride >= count làm tròn lên NN_BLOCK. Kernel không hỗ trợ thì chạy float
+// scalar: int8 scalar chỉ có SSE2 (không madd) nên vẫn chậm hơn float, chỉ giữ để đối chiếu.
+void nnEvaluate(const NnModel& model, NnKernel kernel, const float* soa, int stride, int count, uint8_t* jump);
+
+bool nnDecide(const NnModel& model, const SimState& s);
+
+#endif
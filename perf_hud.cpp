@@ -0,0 +1,101 @@
+#include "perf_hud.h"
+#include "alloc_tracker.h"
+#include "glyph_atlas.h"
+#include "dynamic_resolution.h"
+#include <cstdio>
+
+FrameCounters frameCounters;
+
+static GlyphAtlas hudAtlas;
+static QuadBatch hudBatch;
+static bool hudVisible = false;
+
+static double history[HUD_HISTORY] = {};
+static int historyHead = 0;
+static int historyCount = 0;
+static double hudTargetMs = 1000.0 / 60;
+
+// số liệu của khung vừa xong, hiển thị ở khung kế tiếp
+static int lastDrawCalls = 0;
+static int lastTextureUploads = 0;
+static Uint64 lastAllocations = 0;
+static Uint64 allocMark = 0;
+
+bool initPerfHud(SDL_Renderer* renderer, TTF_Font* font) {
+    allocMark = allocationCount();
+    return buildGlyphAtlas(renderer, font, hudAtlas);
+}
+
+void togglePerfHud() {
+    hudVisible = !hudVisible;
+}
+
+bool perfHudVisible() {
+    return hudVisible;
+}
+
+void perfHudEndFrame(double frameMs, double targetMs) {
+    history[historyHead] = frameMs;
+    historyHead = (historyHead + 1) % HUD_HISTORY;
+    if (historyCount < HUD_HISTORY) historyCount++;
+    hudTargetMs = targetMs;
+
+    Uint64 allocs = allocationCount();
+    lastAllocations = allocs - allocMark;
+    allocMark = allocs;
+    lastDrawCalls = frameCounters.drawCalls;
+    lastTextureUploads = frameCounters.textureUploads;
+    frameCounters = {};
+}
+
+void renderPerfHud(SDL_Renderer* renderer) {
+    if (!hudVisible || !hudAtlas.texture) return;
+
+    double sum = 0;
+    for (int i = 0; i < historyCount; i++) sum += history[i];
+    double meanMs = historyCount ? sum / historyCount : 0;
+    double lastMs = history[(historyHead + HUD_HISTORY - 1) % HUD_HISTORY];
+
+    const float x = 10, y = 10, barW = 2, graphH = 60;
+    const float panelW = HUD_HISTORY * barW + 20;
+    const float line = hudAtlas.lineHeight * 0.5f + 4;
+    const float panelH = line * 5 + graphH + 20;
+    SDL_Color text = {255, 255, 255, 255};
+
+    batchRect(hudBatch, hudAtlas, x, y, panelW, panelH, {0, 0, 0, 170});
+
+    char buf[64];
+    float ty = y + 8;
+    snprintf(buf, sizeof(buf), "FPS %5.1f  %5.2f ms", meanMs > 0 ? 1000.0 / meanMs : 0.0, lastMs);
+    batchText(hudBatch, hudAtlas, x + 10, ty, 0.5f, buf, text);
+    ty += line;
+    snprintf(buf, sizeof(buf), "draws %d  uploads %d", lastDrawCalls, lastTextureUploads);
+    batchText(hudBatch, hudAtlas, x + 10, ty, 0.5f, buf, text);
+    ty += line;
+    snprintf(buf, sizeof(buf), "allocs %llu", (unsigned long long)lastAllocations);
+    batchText(hudBatch, hudAtlas, x + 10, ty, 0.5f, buf, text);
+    ty += line;
+    snprintf(buf, sizeof(buf), "res scale %3d%%", (int)(resolutionScale() * 100 + 0.5f));
+    batchText(hudBatch, hudAtlas, x + 10, ty, 0.5f, buf, text);
+    ty += line + 4;
+
+    // đồ thị thời gian khung, 3 px mỗi ms, cũ nhất bên trái
+    float base = ty + graphH;
+    for (int i = 0; i < historyCount; i++) {
+        double ms = history[(historyHead + HUD_HISTORY - historyCount + i) % HUD_HISTORY];
+        float h = (float)(ms * 3);
+        if (h > graphH) h = graphH;
+        SDL_Color c = ms <= hudTargetMs * 1.1 ? SDL_Color{80, 220, 80, 255}
+                    : ms <= hudTargetMs * 1.5 ? SDL_Color{230, 200, 60, 255}
+                                              : SDL_Color{230, 60, 60, 255};
+        batchRect(hudBatch, hudAtlas, x + 10 + (HUD_HISTORY - historyCount + i) * barW, base - h, barW, h, c);
+    }
+    float targetH = (float)(hudTargetMs * 3);
+    batchRect(hudBatch, hudAtlas, x + 10, base - targetH, HUD_HISTORY * barW, 1, {255, 255, 255, 120});
+
+    frameCounters.drawCalls += flushBatch(renderer, hudAtlas, hudBatch);
+}
+
+void destroyPerfHud() {
+    destroyGlyphAtlas(hudAtlas);
+}
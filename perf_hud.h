@@ -0,0 +1,24 @@
+#ifndef PERF_HUD_H
+#define PERF_HUD_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+// Bộ đếm trong 1 khung, render() tự cộng vào
+struct FrameCounters {
+    int drawCalls = 0;
+    int textureUploads = 0;
+};
+
+extern FrameCounters frameCounters;
+
+const int HUD_HISTORY = 120;    // số khung hiển thị trên đồ thị
+
+bool initPerfHud(SDL_Renderer* renderer, TTF_Font* font);
+void togglePerfHud();
+bool perfHudVisible();
+void perfHudEndFrame(double frameMs, double targetMs);
+void renderPerfHud(SDL_Renderer* renderer);
+void destroyPerfHud();
+
+#endif
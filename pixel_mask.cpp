@@ -0,0 +1,80 @@
+#include "pixel_mask.h"
+#include <algorithm>
+using namespace std;
+
+void buildPixelMask(PixelMask& mask, const uint8_t* alpha, int srcWidth, int srcHeight, int pitch, int stride, int width,
+                    int height, uint8_t threshold) {
+    mask.width = width;
+    mask.height = height;
+    mask.words = (width + 63) / 64;
+    mask.rows.assign((size_t)height * mask.words, 0);
+    mask.left.assign(height, (int16_t)width);
+    mask.right.assign(height, 0);
+    for (int y = 0; y < height; y++) {
+        const uint8_t* src = alpha + (size_t)((2 * y + 1) * srcHeight / (2 * height)) * pitch;
+        uint64_t* row = &mask.rows[(size_t)y * mask.words];
+        for (int x = 0; x < width; x++) {
+            if (src[(2 * x + 1) * srcWidth / (2 * width) * stride] < threshold) continue;
+            row[x >> 6] |= 1ull << (x & 63);
+            mask.left[y] = (int16_t)min((int)mask.left[y], x);
+            mask.right[y] = (int16_t)(x + 1);
+        }
+    }
+    mask.top = height;
+    mask.bottom = 0;
+    mask.minLeft = width;
+    mask.maxRight = 0;
+    for (int y = 0; y < height; y++) {
+        if (mask.left[y] >= mask.right[y]) continue;
+        mask.top = min(mask.top, y);
+        mask.bottom = y + 1;
+        mask.minLeft = min(mask.minLeft, (int)mask.left[y]);
+        mask.maxRight = max(mask.maxRight, (int)mask.right[y]);
+    }
+}
+
+// 64 bit của hàng bắt đầu từ bit offset (có thể âm), ngoài hàng coi là 0
+static inline uint64_t bitsAt(const uint64_t* row, int words, int offset) {
+    int word = offset >> 6;
+    int shift = offset & 63;
+    uint64_t lo = word >= 0 && word < words ? row[word] : 0;
+    if (shift == 0) return lo;
+    uint64_t hi = word + 1 >= 0 && word + 1 < words ? row[word + 1] : 0;
+    return lo >> shift | hi << (64 - shift);
+}
+
+bool masksOverlap(const PixelMask& a, int ax, int ay, const PixelMask& b, int bx, int by, int bHeight, bool flipY) {
+    // khung bao phần đặc; b giãn dọc nên chỉ dùng khung ngang của b
+    int top = max(ay + a.top, by), bottom = min(ay + a.bottom, by + bHeight);
+    if (top >= bottom || ax + a.minLeft >= bx + b.maxRight || bx + b.minLeft >= ax + a.maxRight || b.height == 0) return false;
+
+    int dx = bx - ax;// bit 0 của b nằm ở bit dx của a
+    // hàng nguồn của b theo kiểu DDA 16.16, tránh phép chia mỗi hàng
+    int64_t step = ((int64_t)b.height << 16) / bHeight;
+    int r = flipY ? by + bHeight - 1 - top : top - by;
+    int64_t pos = r * step + step / 2;
+    if (flipY) step = -step;
+    for (int y = top; y < bottom; y++, pos += step) {
+        int ra = y - ay, rb = (int)(pos >> 16);
+        // lọc bằng khoảng đặc của 2 hàng trước khi AND bit
+        int lo = max((int)a.left[ra], b.left[rb] + dx), hi = min((int)a.right[ra], b.right[rb] + dx);
+        if (lo >= hi) continue;
+        const uint64_t* rowA = &a.rows[(size_t)ra * a.words];
+        const uint64_t* rowB = &b.rows[(size_t)rb * b.words];
+        for (int k = lo >> 6; k <= (hi - 1) >> 6; k++) {
+            if (rowA[k] & bitsAt(rowB, b.words, 64 * k - dx)) return true;
+        }
+    }
+    return false;
+}
+
+bool pixelHitsPipe(const SimState& s, int y, const PixelMask& bird, const PixelMask& pipe) {
+    for (int i = 0; i < s.pipeCount; i++) {
+        const Pipe& p = s.pipes[i];
+        if (p.x >= BIRD_X + bird.width || p.x + pipe.width <= BIRD_X) continue;
+        int bottomY = p.height + p.gap;
+        if (masksOverlap(bird, BIRD_X, y, pipe, p.x, 0, p.height, true)) return true;
+        if (masksOverlap(bird, BIRD_X, y, pipe, p.x, bottomY, SCREEN_HEIGHT - bottomY - GROUND_HEIGHT, false)) return true;
+    }
+    return false;
+}
@@ -0,0 +1,30 @@
+#ifndef PIXEL_MASK_H
+#define PIXEL_MASK_H
+
+#include "sim.h"
+#include <cstdint>
+#include <vector>
+
+// Alpha của ảnh nén thành bitmask theo hàng, mỗi hàng words từ 64 bit (pixel x = bit x & 63 của word x >> 6).
+// Va chạm chính xác từng pixel = AND từng hàng của 2 mask sau khi dịch bit, dừng ở hàng đầu tiên chạm.
+struct PixelMask {
+    int width = 0, height = 0;
+    int words = 0;                      // số word mỗi hàng, bit thừa cuối hàng = 0
+    std::vector<uint64_t> rows;         // [height][words]
+    std::vector<int16_t> left, right;   // pixel đặc đầu tiên / sau cuối mỗi hàng, hàng rỗng left >= right
+    int top = 0, bottom = 0;            // khung bao phần đặc, để loại nhanh trước khi duyệt hàng
+    int minLeft = 0, maxRight = 0;
+};
+
+// Lấy mẫu gần nhất alpha (srcWidth x srcHeight, pitch byte/hàng, stride byte/pixel) về width x height;
+// alpha >= threshold là đặc
+void buildPixelMask(PixelMask& mask, const uint8_t* alpha, int srcWidth, int srcHeight, int pitch, int stride, int width,
+                    int height, uint8_t threshold = 128);
+
+// a đặt ở (ax, ay); b đặt ở (bx, by), giãn dọc thành bHeight hàng như khi vẽ, flipY = vẽ lật dọc
+bool masksOverlap(const PixelMask& a, int ax, int ay, const PixelMask& b, int bx, int by, int bHeight, bool flipY);
+
+// Như simHitsPipe() nhưng dùng hình chim và ống đúng như lúc vẽ (ống trên lật dọc, ống giãn theo chiều cao)
+bool pixelHitsPipe(const SimState& s, int y, const PixelMask& bird, const PixelMask& pipe);
+
+#endif
@@ -0,0 +1,91 @@
+#include "pixel_mask.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+
+// Đo va chạm từng pixel so với hitbox chữ nhật thu nhỏ COLLISION_OFFSET hiện tại.
+// Không đọc PNG (công cụ không phụ thuộc SDL): chim là hình elip đặc, ống là thân + mũ rộng hơn, viền trong suốt.
+const int SRC_BIRD = 128;
+const int SRC_PIPE_W = 64, SRC_PIPE_H = 256;
+const int REPEAT = 20;
+
+static void birdAlpha(vector<uint8_t>& alpha) {
+    alpha.assign(SRC_BIRD * SRC_BIRD, 0);
+    for (int y = 0; y < SRC_BIRD; y++) {
+        for (int x = 0; x < SRC_BIRD; x++) {
+            float dx = (x + 0.5f) / SRC_BIRD * 2 - 1, dy = (y + 0.5f) / SRC_BIRD * 2 - 1;
+            if (dx * dx / 0.85f + dy * dy / 0.6f <= 1) alpha[y * SRC_BIRD + x] = 255;
+        }
+    }
+}
+
+static void pipeAlpha(vector<uint8_t>& alpha) {
+    alpha.assign(SRC_PIPE_W * SRC_PIPE_H, 0);
+    for (int y = 0; y < SRC_PIPE_H; y++) {
+        int margin = y < 24 ? 0 : 4;// mũ ống ở đầu ảnh rộng hết, thân hẹp hơn
+        for (int x = margin; x < SRC_PIPE_W - margin; x++) alpha[y * SRC_PIPE_W + x] = 255;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int states = argc > 1 ? atoi(argv[1]) : 200000;
+    if (states <= 0) states = 200000;
+
+    vector<uint8_t> alpha;
+    PixelMask bird, pipe;
+    birdAlpha(alpha);
+    buildPixelMask(bird, alpha.data(), SRC_BIRD, SRC_BIRD, SRC_BIRD, 1, BIRD_SIZE, BIRD_SIZE);
+    pipeAlpha(alpha);
+    buildPixelMask(pipe, alpha.data(), SRC_PIPE_W, SRC_PIPE_H, SRC_PIPE_W, 1, PIPE_WIDTH, SRC_PIPE_H);
+
+    // đường ống thật; y chim phủ đều cả màn hình để có đủ ca sát mép ống
+    vector<SimState> course;
+    vector<int> ys;
+    SimState s;
+    simSeed(s, 99);
+    uint32_t rng = 4242;
+    while ((int)course.size() < states) {
+        simStepPipes(s);
+        course.push_back(s);
+        ys.push_back((int)(simRandom(rng) % (SCREEN_HEIGHT - GROUND_HEIGHT - BIRD_SIZE)));
+    }
+
+    int rectHits = 0, pixelHits = 0, differ = 0, nearPipe = 0;
+    for (int i = 0; i < states; i++) {
+        bool a = simHitsPipe(course[i], ys[i]);
+        bool b = pixelHitsPipe(course[i], ys[i], bird, pipe);
+        rectHits += a;
+        pixelHits += b;
+        differ += a != b;
+        for (int k = 0; k < course[i].pipeCount; k++) {
+            const Pipe& p = course[i].pipes[k];
+            if (p.x < BIRD_X + BIRD_SIZE && p.x + PIPE_WIDTH > BIRD_X) {
+                nearPipe++;
+                break;
+            }
+        }
+    }
+
+    volatile int sink = 0;// giữ kết quả để vòng đo không bị bỏ
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < REPEAT; r++) {
+        for (int i = 0; i < states; i++) sink = sink + simHitsPipe(course[i], ys[i]);
+    }
+    double rectNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / ((double)states * REPEAT);
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < REPEAT; r++) {
+        for (int i = 0; i < states; i++) sink = sink + pixelHitsPipe(course[i], ys[i], bird, pipe);
+    }
+    double pixelNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / ((double)states * REPEAT);
+
+    printf("%d states, %.1f%% with a pipe in the bird column, bird mask %dx%d (%d words/row), pipe mask %dx%d\n", states,
+           100.0 * nearPipe / states, bird.width, bird.height, bird.words, pipe.width, pipe.height);
+    printf("%-10s %10s %10s\n", "test", "ns/test", "hits");
+    printf("%-10s %10.2f %9.2f%%\n", "rect", rectNs, 100.0 * rectHits / states);
+    printf("%-10s %10.2f %9.2f%%\n", "pixel", pixelNs, 100.0 * pixelHits / states);
+    printf("verdicts differ in %.2f%% of states\n", 100.0 * differ / states);
+    return 0;
+}
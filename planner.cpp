@@ -0,0 +1,210 @@
+#include "planner.h"
+#include <algorithm>
+#include <chrono>
+using namespace std;
+
+const int PLAN_SPEED_PENALTY = 4;
+const double PLAN_BUDGET_SHARE = 0.8;   // phần ngân sách dành cho số tầng ước lượng, còn lại bù sai số đo
+const int64_t PLAN_FINISH_NS = 20000;   // chốt chặn cứng dừng sớm chừng này để chờ luồng khác và gộp kết quả
+
+static int64_t nowNs() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static int jobCount(const Planner& planner) {
+    return 2 * max(1, planner.config.samples);
+}
+
+// Chạy hold tick, chỉ nhảy ở tick đầu; trả về số tick còn sống
+static int advance(SimState& s, bool jump, int hold) {
+    for (int i = 0; i < hold; i++) {
+        simStep(s, jump && i == 0);
+        if (s.gameOver) return i + 1;
+    }
+    return hold;
+}
+
+// Sống lâu hơn luôn hơn; cùng số tick thì gần tâm khe ống kế tiếp và bay chậm hơn.
+// Không phạt vận tốc thì beam toàn giữ các node đang lao qua tâm khe, tới ống thì không cứu được.
+static int nodeValue(const SimState& s, int ticks) {
+    if (s.gameOver) return ticks * 1000 - 1000;
+    int target = SCREEN_HEIGHT / 2;
+    for (int i = 0; i < s.pipeCount; i++) {
+        if (s.pipes[i].x + PIPE_WIDTH > BIRD_X + COLLISION_OFFSET) {
+            target = s.pipes[i].height + s.pipes[i].gap / 2;
+            break;
+        }
+    }
+    int center = s.birdY + BIRD_SIZE / 2;
+    int speed = s.birdVelocity < 0 ? -s.birdVelocity : s.birdVelocity;
+    return ticks * 1000 - (center > target ? center - target : target - center) - PLAN_SPEED_PENALTY * speed;
+}
+
+static void runJob(Planner& planner, int job) {
+    const PlannerConfig& config = planner.config;
+    PlanArena& arena = planner.arenas[job];
+    arena.used = 0;
+    arena.expanded = 0;
+    arena.frontier.clear();
+
+    PlanNode& root = arena.nodes[arena.used++];
+    root.state = planner.roots[job];
+    root.value = nodeValue(root.state, advance(root.state, job & 1, config.hold));
+    arena.bestValue = root.value;
+    if (root.state.gameOver) return;
+    arena.frontier.push_back(0);
+
+    int levels = planner.levels;
+    bool expired = false;
+    for (int level = 1; level < levels && !expired; level++) {
+        arena.candidates.clear();
+        int expandedNodes = 0;
+        for (int index : arena.frontier) {
+            // chốt chặn cứng, xét trong tầng vì 1 tầng đủ rộng đã tốn cả ngân sách; 8 node 1 lần cho rẻ.
+            // Tầng dở dang vẫn dùng được: bestValue đã gồm các node con vừa tạo
+            if ((expandedNodes & 7) == 0 && nowNs() > planner.deadline) {
+                planner.overBudget = true;
+                expired = true;
+                break;
+            }
+            expandedNodes++;
+            for (int action = 0; action < 2; action++) {
+                PlanNode& child = arena.nodes[arena.used];
+                child.state = arena.nodes[index].state;
+                child.value = nodeValue(child.state, level * config.hold + advance(child.state, action, config.hold));
+                arena.bestValue = max(arena.bestValue, child.value);
+                if (!child.state.gameOver) arena.candidates.push_back(arena.used);
+                arena.used++;
+            }
+        }
+        arena.expanded += 2 * expandedNodes;
+        if (expired || arena.candidates.empty()) break;
+
+        // giữ beamWidth node tốt nhất; cùng (y, vận tốc) ở cùng tầng là cùng trạng thái nên bỏ bản trùng
+        const vector<PlanNode>& nodes = arena.nodes;
+        sort(arena.candidates.begin(), arena.candidates.end(), [&](int a, int b) {
+            const SimState& sa = nodes[a].state;
+            const SimState& sb = nodes[b].state;
+            if (nodes[a].value != nodes[b].value) return nodes[a].value > nodes[b].value;
+            if (sa.birdY != sb.birdY) return sa.birdY < sb.birdY;
+            return sa.birdVelocity < sb.birdVelocity;
+        });
+        arena.frontier.clear();
+        int last = -1;
+        for (int index : arena.candidates) {
+            if ((int)arena.frontier.size() == config.beamWidth) break;
+            const SimState& s = nodes[index].state;
+            if (last >= 0 && nodes[last].state.birdY == s.birdY && nodes[last].state.birdVelocity == s.birdVelocity) continue;
+            arena.frontier.push_back(index);
+            last = index;
+        }
+    }
+}
+
+static void runJobs(Planner& planner) {
+    int count = jobCount(planner);
+    for (int job = planner.nextJob++; job < count; job = planner.nextJob++) {
+        runJob(planner, job);
+        if (++planner.doneJobs == count) planner.doneJobs.notify_all();
+    }
+}
+
+static void workerLoop(Planner& planner, uint32_t seen) {
+    while (true) {
+        planner.generation.wait(seen);
+        seen = planner.generation.load();
+        if (planner.stopping) return;
+        runJobs(planner);
+    }
+}
+
+void initPlanner(Planner& planner, const PlannerConfig& config) {
+    destroyPlanner(planner);
+    planner.config = config;
+    planner.config.hold = max(1, config.hold);
+    planner.config.beamWidth = max(1, config.beamWidth);
+
+    // cấp phát đủ cho cả cây 1 lần: mỗi tầng tối đa 2 * beamWidth node con
+    int levels = planner.config.lookahead / planner.config.hold;
+    int capacity = 1 + max(0, levels - 1) * 2 * planner.config.beamWidth;
+    int jobs = jobCount(planner);
+    planner.arenas.assign(jobs, PlanArena());
+    for (PlanArena& arena : planner.arenas) {
+        arena.nodes.resize(capacity);
+        arena.frontier.reserve(planner.config.beamWidth);
+        arena.candidates.reserve(2 * planner.config.beamWidth);
+    }
+    planner.roots.resize(jobs);
+
+    planner.stopping = false;
+    uint32_t generation = planner.generation.load();
+    for (int i = 1; i < config.threads; i++) planner.workers.emplace_back(workerLoop, ref(planner), generation);
+}
+
+void destroyPlanner(Planner& planner) {
+    planner.stopping = true;
+    planner.generation++;
+    planner.generation.notify_all();
+    for (auto& worker : planner.workers) worker.join();
+    planner.workers.clear();
+}
+
+bool planJump(Planner& planner, const SimState& s, PlanStats* stats) {
+    if (planner.committed > 0 && s.tick == planner.lastTick + 1) {
+        planner.committed--;
+        planner.lastTick = s.tick;
+        if (stats) *stats = PlanStats();
+        return false;
+    }
+
+    int64_t start = nowNs();
+    int samples = planner.config.samples;
+    int jobs = jobCount(planner);
+    for (int job = 0; job < jobs; job += 2) {
+        SimState root = s;
+        if (samples > 0) root.rng = simRandom(planner.sampleRng);// ống đã hiện thì biết, ống chưa sinh thì đoán
+        planner.roots[job] = root;
+        planner.roots[job + 1] = root;
+    }
+    // chọn độ sâu từ thời gian/node đo được ở các lần trước, để mọi job cùng độ sâu mà vẫn kịp hạn;
+    // so kịch bản tệ nhất giữa các job bị cắt ở độ sâu khác nhau thì job cạn luôn thua oan.
+    // Tính như mọi tầng đều đủ 2 * beamWidth node nên thường dư hạn, tầng bị bỏ trùng thì rẻ hơn
+    int maxLevels = planner.config.lookahead / planner.config.hold;
+    planner.levels = maxLevels;
+    if (planner.nodeNs > 0) {
+        double perJob = planner.config.budgetMs * 1e6 * PLAN_BUDGET_SHARE / planner.nodeNs / jobs;
+        planner.levels = clamp(1 + (int)(perJob / (2 * planner.config.beamWidth)), 2, maxLevels);
+    }
+    planner.deadline = start + (int64_t)(planner.config.budgetMs * 1e6) - PLAN_FINISH_NS;
+    planner.overBudget = false;
+    planner.doneJobs = 0;
+    planner.nextJob = 0;
+    planner.generation++;
+    planner.generation.notify_all();
+
+    runJobs(planner);// thread gọi cũng làm việc
+    for (int done = planner.doneJobs.load(); done < jobs; done = planner.doneJobs.load()) planner.doneJobs.wait(done);
+
+    // mỗi hành động lấy kịch bản tệ nhất
+    int value[2] = {INT32_MAX, INT32_MAX};
+    long long nodes = 0;
+    for (int job = 0; job < jobs; job++) {
+        value[job & 1] = min(value[job & 1], planner.arenas[job].bestValue);
+        nodes += planner.arenas[job].expanded;
+    }
+    // ns (đồng hồ thật) mỗi node, đã gồm song song và chi phí gộp; trung bình trượt cho đỡ nhiễu
+    int64_t elapsed = nowNs() - start;
+    if (nodes > 0) {
+        double measured = (double)elapsed / nodes;
+        planner.nodeNs = planner.nodeNs > 0 ? 0.9 * planner.nodeNs + 0.1 * measured : measured;
+    }
+    if (stats) {
+        stats->planned = true;
+        stats->nodes = nodes;
+        stats->ms = elapsed / 1e6;
+        stats->overBudget = planner.overBudget;
+    }
+    planner.committed = planner.config.hold - 1;
+    planner.lastTick = s.tick;
+    return value[1] > value[0];
+}
@@ -0,0 +1,66 @@
+#ifndef PLANNER_H
+#define PLANNER_H
+
+#include "sim.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Bot lập kế hoạch: beam search trên chuỗi nhảy/không nhảy bằng cách chạy simStep() trên bản sao SimState.
+// Mỗi job = (hành động đầu tiên, 1 kịch bản rng); các job chạy song song, mỗi job 1 arena riêng.
+struct PlannerConfig {
+    int lookahead = 300;        // số tick nhìn trước, ~3 ống
+    int hold = 3;               // mỗi tầng của cây = hold tick, chỉ được nhảy ở tick đầu
+    int beamWidth = 24;
+    int samples = 0;            // 0 = biết rng thật (kéo theo ống sau); > 0 = số kịch bản rng lấy mẫu
+    int threads = 1;            // tính cả thread gọi planJump()
+    double budgetMs = 1.0;      // độ sâu chọn theo thời gian/node đo được; quá hạn thì dừng ngay giữa tầng
+};
+
+struct PlanNode {
+    SimState state;
+    int value;
+};
+
+// Cấp phát kiểu bump, reset mỗi lần lập kế hoạch; không đụng heap trong lúc tìm
+struct PlanArena {
+    std::vector<PlanNode> nodes;
+    std::vector<int> frontier, candidates;
+    int used = 0;
+    int bestValue = 0;
+    long long expanded = 0;
+};
+
+struct PlanStats {
+    bool planned = false;       // false = tick đang giữ hành động cũ, không tìm
+    long long nodes = 0;        // số node con đã tạo
+    double ms = 0;
+    bool overBudget = false;
+};
+
+struct Planner {
+    PlannerConfig config;
+    std::vector<PlanArena> arenas;          // 1 arena/job
+    std::vector<SimState> roots;            // gốc của từng job
+    std::vector<std::thread> workers;
+    std::atomic<uint32_t> generation{0};
+    std::atomic<int> nextJob{0}, doneJobs{0};
+    std::atomic<bool> stopping{false};
+    int64_t deadline = 0;
+    int levels = 0;                         // độ sâu của lần lập kế hoạch này
+    double nodeNs = 0;                      // ns mỗi node đo được, 0 = chưa đo
+    std::atomic<bool> overBudget{false};
+    uint32_t sampleRng = 0x1234567u;
+    int committed = 0;                      // số tick còn lại của hành động gốc đã chọn
+    uint32_t lastTick = 0;
+};
+
+void initPlanner(Planner& planner, const PlannerConfig& config);
+void destroyPlanner(Planner& planner);
+
+// true = nhảy ở tick này. Hành động gốc giữ đủ hold tick rồi mới lập kế hoạch lại,
+// để các điểm nhảy trùng lưới với lần tìm trước (đổi pha mỗi tick thì đường sống vừa tìm có thể biến mất)
+bool planJump(Planner& planner, const SimState& s, PlanStats* stats = nullptr);
+
+#endif
@@ -0,0 +1,76 @@
+#include "planner.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Đo bot lập kế hoạch: node/giây, thời gian mỗi lần lập kế hoạch so với ngân sách 1 ms, điểm trung bình.
+// Thoát khác 0 nếu p99 vượt ngân sách: ngân sách là giới hạn cứng của thread mô phỏng, không phải mục tiêu trung bình
+const int DEFAULT_GAMES = 20;
+const int MAX_TICKS = 3600;             // 1 phút chơi ở 60 Hz
+
+struct BenchMode {
+    const char* name;
+    int samples;
+};
+
+int main(int argc, char* argv[]) {
+    int games = argc > 1 ? atoi(argv[1]) : DEFAULT_GAMES;
+    if (games <= 0) games = DEFAULT_GAMES;
+    int threads = argc > 2 ? atoi(argv[2]) : (int)thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+
+    BenchMode modes[] = {
+        {"known-rng", 0},
+        {"sampled-4", 4},
+    };
+
+    printf("%d games per mode, %d ticks max, %d threads\n", games, MAX_TICKS, threads);
+    printf("%-10s %9s %11s %12s %10s %10s %10s %10s %11s\n", "mode", "survival", "mean score", "Mnodes/s",
+           "mean ms", "p99 ms", "max ms", "cut short", "over budget");
+    bool ok = true;
+    for (const BenchMode& mode : modes) {
+        PlannerConfig config;
+        config.samples = mode.samples;
+        config.threads = threads;
+        Planner planner;
+        initPlanner(planner, config);
+
+        int survived = 0;
+        long long totalScore = 0, totalNodes = 0, cutShort = 0, overBudget = 0;
+        double totalMs = 0;
+        vector<double> decisionMs;
+        decisionMs.reserve((size_t)games * MAX_TICKS);
+        for (int game = 0; game < games; game++) {
+            SimState s;
+            simSeed(s, 1000 + game);
+            while (!s.gameOver && (int)s.tick < MAX_TICKS) {
+                PlanStats stats;
+                bool jump = planJump(planner, s, &stats);
+                simStep(s, jump);
+                if (!stats.planned) continue;
+                totalNodes += stats.nodes;
+                totalMs += stats.ms;
+                cutShort += stats.overBudget;
+                overBudget += stats.ms > config.budgetMs;
+                decisionMs.push_back(stats.ms);
+            }
+            if (!s.gameOver) survived++;
+            totalScore += s.score;
+        }
+        destroyPlanner(planner);
+
+        sort(decisionMs.begin(), decisionMs.end());
+        double p99 = decisionMs[decisionMs.size() * 99 / 100];
+        printf("%-10s %8.1f%% %11.1f %12.2f %10.3f %10.3f %10.3f %9.2f%% %10.2f%%\n", mode.name, 100.0 * survived / games,
+               (double)totalScore / games, totalNodes / totalMs / 1e3, totalMs / decisionMs.size(), p99,
+               decisionMs.back(), 100.0 * cutShort / decisionMs.size(), 100.0 * overBudget / decisionMs.size());
+        if (p99 > config.budgetMs) {
+            printf("%s: p99 %.3f ms exceeds the %.3f ms budget\n", mode.name, p99, config.budgetMs);
+            ok = false;
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+#include "population.h"
+#include "autopilot.h"
+#include "fixed_step.h"
+
+void spawnPopulation(Population& population, int count, uint32_t seed) {
+    if (count > POPULATION_MAX) count = POPULATION_MAX;
+    simSeed(population.course, seed);
+    population.rng = seed * 2654435761u + 1;
+    population.alive = count;
+    initBroadPhase(population.broad, POPULATION_MAX);
+    for (int i = 0; i < count; i++) {
+        // lệch lẻ pixel để đàn tản mượt, không chồng thành từng lớp theo pixel
+        population.y[i] = toFixed(SCREEN_HEIGHT / 2 - 150) + (Fixed)(simRandom(population.rng) % toFixed(250));
+        population.velocity[i] = toFixed(-10) + (Fixed)(simRandom(population.rng) % toFixed(16));
+        population.id[i] = (uint16_t)i;
+        population.slip[i] = (uint16_t)(simRandom(population.rng) % 2000);// tối đa ~3%
+    }
+}
+
+int stepPopulation(Population& population, const NnModel* policy) {
+    Population& p = population;
+    SimState view = p.course;// ống hiện tại, thay y/vận tốc từng chim vào để hỏi policy
+    if (policy) {
+        float features[NN_INPUTS];
+        for (int i = 0; i < p.alive; i++) {
+            view.birdY = fixedFloor(p.y[i]);
+            view.birdVelocity = fixedFloor(p.velocity[i]);
+            nnFeatures(view, features);
+            for (int k = 0; k < NN_INPUTS; k++) p.soa[k * POPULATION_MAX + i] = features[k];
+        }
+        nnEvaluate(*policy, NN_FLOAT_AVX2, p.soa, POPULATION_MAX, p.alive, p.jump);
+    } else {
+        for (int i = 0; i < p.alive; i++) {
+            view.birdY = fixedFloor(p.y[i]);
+            view.birdVelocity = fixedFloor(p.velocity[i]);
+            p.jump[i] = autopilotDecide(view);
+        }
+    }
+
+    // cùng thứ tự như simStep(): chim, rồi ống, rồi va chạm với ống đã dịch
+    for (int i = 0; i < p.alive; i++) p.jump[i] = p.jump[i] && (simRandom(p.rng) & 0xFFFF) >= p.slip[i];
+    stepBirdsFixed(FIXED_AVX2, p.y, p.velocity, p.jump, p.alive, p.dead);
+    simStepPipes(p.course);
+    simScorePipes(p.course);
+    p.course.tick++;
+    collideBirds(p.broad, p.course, p.y, p.alive, p.dead);
+
+    int died = 0;
+    for (int i = 0; i < p.alive;) {
+        if (!p.dead[i]) {
+            i++;
+            continue;
+        }
+        int last = --p.alive;
+        p.y[i] = p.y[last];
+        p.velocity[i] = p.velocity[last];
+        p.id[i] = p.id[last];
+        p.slip[i] = p.slip[last];
+        p.dead[i] = p.dead[last];
+        died++;
+    }
+    return died;
+}
@@ -0,0 +1,33 @@
+#ifndef POPULATION_H
+#define POPULATION_H
+
+#include "sim.h"
+#include "nn_policy.h"
+#include "broad_phase.h"
+#include "fixed.h"
+#include <cstdint>
+
+// Chế độ đàn chim: rất nhiều chim bay chung 1 đường ống, mỗi chim chỉ có y, vận tốc (số cố định, lẻ pixel).
+// Ống và điểm nằm trong course, chỉ bước 1 lần mỗi tick cho cả đàn.
+const int POPULATION_MAX = 10000;
+
+struct Population {
+    SimState course;
+    int alive = 0;
+    // chim còn sống nằm liền ở [0, alive), chim chết bị đổi chỗ với chim cuối
+    Fixed y[POPULATION_MAX];
+    Fixed velocity[POPULATION_MAX];
+    uint16_t id[POPULATION_MAX];        // cố định theo chim, để tô màu
+    uint16_t slip[POPULATION_MAX];      // xác suất bỏ lỡ 1 cú nhảy (/65536), để đàn tản ra dần
+    uint32_t rng = 1;
+    float soa[NN_INPUTS * POPULATION_MAX];
+    uint8_t jump[POPULATION_MAX];
+    uint8_t dead[POPULATION_MAX];
+    BroadPhase broad;
+};
+
+void spawnPopulation(Population& population, int count, uint32_t seed);
+// policy == nullptr thì mỗi chim dùng autopilot; trả về số chim chết trong tick này
+int stepPopulation(Population& population, const NnModel* policy);
+
+#endif
@@ -0,0 +1,86 @@
+#include "profiler.h"
+
+#ifdef FLAPPY_PROFILE
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <vector>
+using namespace std;
+
+const int PROFILE_RING_SIZE = 1 << 16;  // số zone giữ lại mỗi thread, phải là lũy thừa của 2
+
+struct ProfileEvent {
+    const char* name;
+    Uint64 start, end;
+};
+
+// Mỗi thread ghi vào ring riêng, chỉ có 1 writer nên không cần khoá
+struct ProfileRing {
+    ProfileEvent events[PROFILE_RING_SIZE];
+    atomic<Uint64> head{0};
+    int tid = 0;
+    const char* threadName = nullptr;
+};
+
+static mutex registryMutex;          // chỉ dùng khi thread đăng ký lần đầu và khi dump
+static vector<ProfileRing*> rings;   // không giải phóng để dump được cả thread đã kết thúc
+static atomic<int> nextTid{1};
+static thread_local ProfileRing* localRing = nullptr;
+static const Uint64 epoch = SDL_GetPerformanceCounter();
+
+static ProfileRing* threadRing() {
+    if (!localRing) {
+        localRing = new ProfileRing();
+        localRing->tid = nextTid++;
+        lock_guard<mutex> lock(registryMutex);
+        rings.push_back(localRing);
+    }
+    return localRing;
+}
+
+void profileRecord(const char* name, Uint64 start, Uint64 end) {
+    ProfileRing* ring = threadRing();
+    Uint64 h = ring->head.load(memory_order_relaxed);
+    ring->events[h & (PROFILE_RING_SIZE - 1)] = {name, start, end};
+    ring->head.store(h + 1, memory_order_release);
+}
+
+void profileSetThreadName(const char* name) {
+    threadRing()->threadName = name;
+}
+
+bool profileDump(const char* path) {
+    ofstream file(path);
+    if (!file.is_open()) return false;
+
+    double usPerTick = 1000000.0 / (double)SDL_GetPerformanceFrequency();
+    bool first = true;
+    file << "{\"traceEvents\":[\n";
+
+    lock_guard<mutex> lock(registryMutex);
+    for (ProfileRing* ring : rings) {
+        if (ring->threadName) {
+            file << (first ? "" : ",\n")
+                 << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->tid
+                 << ",\"args\":{\"name\":\"" << ring->threadName << "\"}}";
+            first = false;
+        }
+
+        // bỏ 1/16 ring cũ nhất vì writer có thể đang ghi đè lên đó
+        Uint64 h = ring->head.load(memory_order_acquire);
+        Uint64 keep = PROFILE_RING_SIZE - PROFILE_RING_SIZE / 16;
+        Uint64 from = h > keep ? h - keep : 0;
+        for (Uint64 i = from; i < h; i++) {
+            const ProfileEvent& e = ring->events[i & (PROFILE_RING_SIZE - 1)];
+            if (e.start < epoch) continue;
+            file << (first ? "" : ",\n")
+                 << "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->tid
+                 << ",\"ts\":" << (double)(e.start - epoch) * usPerTick
+                 << ",\"dur\":" << (double)(e.end - e.start) * usPerTick << "}";
+            first = false;
+        }
+    }
+    file << "\n]}\n";
+    return true;
+}
+#endif
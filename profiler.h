@@ -0,0 +1,31 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Bật bằng -DFLAPPY_PROFILE=ON, tắt thì mọi macro biến mất hoàn toàn
+#ifdef FLAPPY_PROFILE
+#include <SDL2/SDL.h>
+
+void profileRecord(const char* name, Uint64 start, Uint64 end);
+void profileSetThreadName(const char* name);
+bool profileDump(const char* path);
+
+struct ProfileScope {
+    const char* name;
+    Uint64 start;
+
+    explicit ProfileScope(const char* name) : name(name), start(SDL_GetPerformanceCounter()) {}
+    ~ProfileScope() { profileRecord(name, start, SDL_GetPerformanceCounter()); }
+};
+
+#define PROFILE_CONCAT2(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT2(a, b)
+#define PROFILE_ZONE(name) ProfileScope PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_THREAD(name) profileSetThreadName(name)
+#define PROFILE_DUMP(path) profileDump(path)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#define PROFILE_DUMP(path) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,133 @@
+#include "rewind.h"
+#include <algorithm>
+using namespace std;
+
+static void applyDelta(SimState& s, RewindDelta d) {
+    s.birdY += d.dy;
+    s.birdVelocity += d.dv;
+    if (d.flags & REWIND_REMOVED) {
+        for (int i = 1; i < s.pipeCount; i++) s.pipes[i - 1] = s.pipes[i];
+        s.pipeCount--;
+    }
+    for (int i = 0; i < s.pipeCount; i++) s.pipes[i].x -= d.shift;
+    if (d.flags & REWIND_SCORED) {
+        s.score++;
+        for (int i = 0; i < s.pipeCount; i++) {
+            if (!s.pipes[i].scored) {
+                s.pipes[i].scored = true;
+                break;
+            }
+        }
+    }
+    if (d.flags & REWIND_GAME_OVER) s.gameOver = true;
+    s.tick++;
+}
+
+// So từng trường, SimState có byte đệm nên không memcmp được
+static bool sameState(const SimState& a, const SimState& b) {
+    if (a.birdY != b.birdY || a.birdVelocity != b.birdVelocity || a.pipeCount != b.pipeCount || a.score != b.score
+        || a.gameOver != b.gameOver || a.rng != b.rng || a.tick != b.tick) return false;
+    for (int i = 0; i < a.pipeCount; i++) {
+        const Pipe& p = a.pipes[i];
+        const Pipe& q = b.pipes[i];
+        if (p.x != q.x || p.height != q.height || p.scored != q.scored || p.gap != q.gap) return false;
+    }
+    return true;
+}
+
+// Đoán delta từ 2 trạng thái liên tiếp rồi áp thử; chỉ nhận khi tái tạo đúng y nguyên
+static bool encodeDelta(const SimState& prev, const SimState& cur, RewindDelta& d) {
+    int dy = cur.birdY - prev.birdY, dv = cur.birdVelocity - prev.birdVelocity;
+    if (dy < INT8_MIN || dy > INT8_MAX || dv < INT8_MIN || dv > INT8_MAX) return false;
+    bool removed = cur.pipeCount == prev.pipeCount - 1;
+    int shift = cur.pipeCount > 0 ? prev.pipes[removed].x - cur.pipes[0].x : 0;
+    if (shift < 0 || shift > UINT8_MAX) return false;
+
+    d = {(int8_t)dy, (int8_t)dv, (uint8_t)shift, 0};
+    if (removed) d.flags |= REWIND_REMOVED;
+    if (cur.score == prev.score + 1) d.flags |= REWIND_SCORED;
+    if (cur.gameOver && !prev.gameOver) d.flags |= REWIND_GAME_OVER;
+    SimState check = prev;
+    applyDelta(check, d);
+    return sameState(check, cur);
+}
+
+void initRewind(RewindBuffer& rewind, int ticks) {
+    // delta giữ thêm 1 khoảng keyframe: tick cũ nhất lùi được là keyframe cũ nhất còn đủ delta sau nó,
+    // mà keyframe cách nhau tới REWIND_KEY_INTERVAL tick, nên vòng đúng ticks thì cửa sổ hụt tới chừng đó
+    rewind.capacity = ticks + REWIND_KEY_INTERVAL;
+    rewind.deltas.assign(rewind.capacity, RewindDelta{});
+    // keyframe định kỳ (1/32 tick) + mỗi lần sinh ống (~1/100 tick, 1/48 ở đường ống sinh dần khó nhất);
+    // đủ cho 1 keyframe mỗi 16 tick, thiếu thì cửa sổ ngắn lại chứ không sai
+    rewind.keys.assign(rewind.capacity / 16 + 2, RewindKey{});
+    clearRewind(rewind);
+}
+
+void clearRewind(RewindBuffer& rewind) {
+    rewind.keyHead = 0;
+    rewind.keyCount = 0;
+    rewind.records = 0;
+    rewind.lastKey = 0;
+    rewind.oldestDelta = 0;
+}
+
+static const RewindKey& keyAt(const RewindBuffer& rewind, int i) {
+    return rewind.keys[(rewind.keyHead + i) % rewind.keys.size()];
+}
+
+void recordRewind(RewindBuffer& rewind, const SimState& s) {
+    RewindDelta d;
+    if (rewind.records > 0 && rewind.records - rewind.lastKey < REWIND_KEY_INTERVAL && encodeDelta(rewind.last, s, d)) {
+        rewind.deltas[rewind.records % rewind.capacity] = d;
+    } else {
+        int slots = (int)rewind.keys.size();
+        if (rewind.keyCount == slots) rewind.keyHead = (rewind.keyHead + 1) % slots;// đè keyframe cũ nhất
+        else rewind.keyCount++;
+        RewindKey& key = rewind.keys[(rewind.keyHead + rewind.keyCount - 1) % slots];
+        key.record = rewind.records;
+        key.state = s;
+        rewind.lastKey = rewind.records;
+    }
+    if (rewind.records >= (uint32_t)rewind.capacity) rewind.oldestDelta = max(rewind.oldestDelta, rewind.records - rewind.capacity + 1);
+    rewind.last = s;
+    rewind.records++;
+}
+
+// Keyframe cũ nhất mà delta sau nó còn trong vòng; -1 nếu không có
+static int oldestUsableKey(const RewindBuffer& rewind) {
+    for (int i = 0; i < rewind.keyCount; i++)
+        if (keyAt(rewind, i).record + 1 >= rewind.oldestDelta) return i;
+    return -1;
+}
+
+int rewindAvailable(const RewindBuffer& rewind) {
+    int oldest = oldestUsableKey(rewind);
+    if (oldest < 0) return -1;
+    return (int)(rewind.records - 1 - keyAt(rewind, oldest).record);
+}
+
+bool restoreRewind(const RewindBuffer& rewind, int ticksBack, SimState& out) {
+    if (ticksBack < 0 || ticksBack > rewindAvailable(rewind)) return false;
+    uint32_t target = rewind.records - 1 - ticksBack;
+
+    // keyframe mới nhất không sau target, tìm nhị phân trên vòng (record tăng dần)
+    int lo = 0, hi = rewind.keyCount - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (keyAt(rewind, mid).record <= target) lo = mid;
+        else hi = mid - 1;
+    }
+    const RewindKey& key = keyAt(rewind, lo);
+    out = key.state;
+    for (uint32_t r = key.record + 1; r <= target; r++) applyDelta(out, rewind.deltas[r % rewind.capacity]);
+    return true;
+}
+
+bool rewindTo(RewindBuffer& rewind, int ticksBack, SimState& out) {
+    if (!restoreRewind(rewind, ticksBack, out)) return false;
+    rewind.records -= ticksBack;
+    while (rewind.keyCount > 0 && keyAt(rewind, rewind.keyCount - 1).record >= rewind.records) rewind.keyCount--;
+    rewind.lastKey = keyAt(rewind, rewind.keyCount - 1).record;
+    rewind.last = out;
+    return true;
+}
@@ -0,0 +1,59 @@
+#ifndef REWIND_H
+#define REWIND_H
+
+#include "sim.h"
+#include <cstdint>
+#include <vector>
+
+// Lịch sử vài giây gần nhất để tua lại (chế độ luyện tập, gỡ lỗi).
+// Mỗi tick chỉ ghi 4 byte chênh lệch: dy, dv của chim, quãng ống dịch trái, và cờ (ghi điểm, bỏ ống, game over).
+// Tick nào không mô tả được như vậy (sinh ống làm đổi rng, ván mới...) thì ghi nguyên SimState làm keyframe,
+// ngoài ra cứ REWIND_KEY_INTERVAL tick 1 keyframe để khôi phục chỉ cần cộng tối đa chừng đó delta.
+const int REWIND_KEY_INTERVAL = 32;
+
+enum RewindFlags : uint8_t {
+    REWIND_SCORED = 1,      // score++ và đánh dấu ống đầu tiên chưa tính điểm
+    REWIND_REMOVED = 2,     // ống đầu ra khỏi màn hình
+    REWIND_GAME_OVER = 4,
+};
+
+struct RewindDelta {
+    int8_t dy, dv;
+    uint8_t shift;          // px mọi ống dịch trái
+    uint8_t flags;
+};
+
+struct RewindKey {
+    uint32_t record;        // số thứ tự tick được ghi
+    SimState state;
+};
+
+struct RewindBuffer {
+    int capacity = 0;                   // số delta trong vòng = số tick hứa lùi được + REWIND_KEY_INTERVAL
+    std::vector<RewindDelta> deltas;    // vòng, theo record % capacity
+    std::vector<RewindKey> keys;        // vòng, record tăng dần
+    int keyHead = 0, keyCount = 0;
+    uint32_t records = 0;               // tổng số tick đã ghi
+    uint32_t lastKey = 0;               // record của keyframe mới nhất
+    uint32_t oldestDelta = 0;           // delta cũ nhất chưa bị ghi đè (tua về rồi ghi tiếp thì không còn là records - capacity)
+    SimState last;                      // trạng thái vừa ghi, để tính delta tick sau
+};
+
+// Cấp phát 1 lần; sau đó ghi/khôi phục không cấp phát. Luôn lùi được ít nhất ticks tick
+// (trừ khi keyframe dày bất thường làm đầy vòng keyframe)
+void initRewind(RewindBuffer& rewind, int ticks);
+void clearRewind(RewindBuffer& rewind);
+
+// Gọi 1 lần mỗi tick sau khi bước mô phỏng
+void recordRewind(RewindBuffer& rewind, const SimState& s);
+
+// Số tick lùi được tối đa (0 = chỉ có tick mới nhất, -1 = rỗng)
+int rewindAvailable(const RewindBuffer& rewind);
+
+// Trạng thái ticksBack tick trước tick mới nhất; false nếu đã ra khỏi lịch sử
+bool restoreRewind(const RewindBuffer& rewind, int ticksBack, SimState& out);
+
+// Như restoreRewind rồi bỏ các tick sau đó, để chơi tiếp từ điểm tua về
+bool rewindTo(RewindBuffer& rewind, int ticksBack, SimState& out);
+
+#endif
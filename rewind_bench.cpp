@@ -0,0 +1,78 @@
+#include "rewind.h"
+#include "autopilot.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+
+// Ghi lịch sử các ván autopilot có xen nhảy ngẫu nhiên (để có chết, ván mới), so mọi lần khôi phục
+// với bản sao đầy đủ từng tick, rồi đo bộ nhớ và thời gian khôi phục.
+const int SECONDS = 10;
+const int TICKS = SECONDS * 60;
+const int HISTORY = TICKS + REWIND_KEY_INTERVAL;// cửa sổ thực có thể dài hơn TICKS tới chừng này
+
+static bool same(const SimState& a, const SimState& b) {
+    if (a.birdY != b.birdY || a.birdVelocity != b.birdVelocity || a.pipeCount != b.pipeCount || a.score != b.score
+        || a.gameOver != b.gameOver || a.rng != b.rng || a.tick != b.tick) return false;
+    for (int i = 0; i < a.pipeCount; i++)
+        if (a.pipes[i].x != b.pipes[i].x || a.pipes[i].height != b.pipes[i].height || a.pipes[i].scored != b.pipes[i].scored
+            || a.pipes[i].gap != b.pipes[i].gap) return false;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int steps = argc > 1 ? atoi(argv[1]) : 200000;
+    if (steps <= 0) steps = 200000;
+
+    RewindBuffer rewind;
+    initRewind(rewind, TICKS);
+    vector<SimState> full(HISTORY + 1);// đối chứng: bản sao đầy đủ mỗi tick
+    SimState s;
+    simSeed(s, 4242);
+    uint32_t rng = 99;
+    long long checks = 0, mismatches = 0, keyframes = 0, minWindow = HISTORY, rewinds = 0;
+    for (int t = 0; t < steps; t++) {
+        if (s.gameOver) simReset(s);
+        else simStep(s, simRandom(rng) % 400 == 0 ? !autopilotDecide(s) : autopilotDecide(s));
+        uint32_t before = rewind.lastKey;
+        recordRewind(rewind, s);
+        keyframes += rewind.lastKey != before || t == 0;
+        full[(rewind.records - 1) % (HISTORY + 1)] = s;
+
+        int available = rewindAvailable(rewind);
+        if (t >= TICKS && rewinds == 0) minWindow = min(minWindow, (long long)available);
+        int back = (int)(simRandom(rng) % (available + 1));
+        SimState restored;
+        checks++;
+        if (!restoreRewind(rewind, back, restored) || !same(restored, full[(rewind.records - 1 - back) % (HISTORY + 1)])) mismatches++;
+
+        // nửa sau thỉnh thoảng tua về rồi chơi tiếp từ đó như người chơi luyện tập
+        if (t > steps / 2 && simRandom(rng) % 500 == 0 && rewindTo(rewind, back, s)) rewinds++;
+    }
+
+    // thời gian khôi phục: mọi độ lùi trong cửa sổ, lấy trung bình và tệ nhất
+    int available = rewindAvailable(rewind);
+    double sumNs = 0, worstNs = 0;
+    volatile int sink = 0;
+    for (int back = 0; back <= available; back++) {
+        SimState restored;
+        auto start = chrono::steady_clock::now();
+        for (int rep = 0; rep < 100; rep++) {
+            restoreRewind(rewind, back, restored);
+            sink = sink + restored.birdY;
+        }
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / 100;
+        sumNs += ns;
+        worstNs = max(worstNs, ns);
+    }
+
+    size_t bytes = rewind.deltas.size() * sizeof(RewindDelta) + rewind.keys.size() * sizeof(RewindKey);
+    printf("%d ticks recorded, window %d ticks (min %lld after warm-up), %lld rewinds, %lld checks, %lld mismatches\n", steps, TICKS,
+           minWindow, rewinds, checks, mismatches);
+    printf("keyframes %.1f%% of ticks, %zu bytes vs %zu for full copies (%.1fx smaller)\n", 100.0 * keyframes / steps, bytes,
+           TICKS * sizeof(SimState), (double)(TICKS * sizeof(SimState)) / bytes);
+    printf("restore: mean %.0f ns, worst %.0f ns\n", sumNs / (available + 1), worstNs);
+    if (minWindow < TICKS) printf("window fell to %lld ticks, below the promised %d\n", minWindow, TICKS);
+    return mismatches == 0 && minWindow >= TICKS ? 0 : 1;
+}
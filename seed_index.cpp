@@ -0,0 +1,70 @@
+#include "seed_index.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <cstring>
+using namespace std;
+
+static MappedFile indexFile;
+static const SeedEntry* entries = nullptr;
+static uint32_t entryCount = 0;
+
+SeedIndexHeader seedIndexExpectedHeader(SeedHitbox hitbox, uint32_t rollouts, uint32_t count) {
+    SeedIndexHeader header = {};
+    memcpy(header.magic, "FLSI", 4);
+    header.version = 2;
+    header.gravity = GRAVITY;
+    header.jumpStrength = JUMP_STRENGTH;
+    header.pipeGap = PIPE_GAP;
+    header.pipeSpeed = PIPE_SPEED;
+    header.pipeWidth = PIPE_WIDTH;
+    header.pipeSpawnX = PIPE_SPAWN_X;
+    header.coursePipes = SEED_COURSE_PIPES;
+    header.hitbox = hitbox;
+    header.rollouts = rollouts;
+    header.count = count;
+    return header;
+}
+
+bool loadSeedIndex(const char* path, SeedHitbox hitbox) {
+    unloadSeedIndex();
+    if (!mapFile(indexFile, path)) return false;
+
+    // rollouts và count lấy từ file, phần luật chơi và phép thử va chạm phải khớp
+    SeedIndexHeader header;
+    if (indexFile.size < sizeof(header)) {
+        unmapFile(indexFile);
+        return false;
+    }
+    memcpy(&header, indexFile.data, sizeof(header));
+    SeedIndexHeader expected = seedIndexExpectedHeader(hitbox, header.rollouts, header.count);
+    if (memcmp(&header, &expected, sizeof(header)) != 0 || header.count == 0
+        || indexFile.size != sizeof(header) + (size_t)header.count * sizeof(SeedEntry)) {
+        unmapFile(indexFile);
+        return false;
+    }
+    entries = (const SeedEntry*)(indexFile.data + sizeof(header));
+    entryCount = header.count;
+    return true;
+}
+
+void unloadSeedIndex() {
+    entries = nullptr;
+    entryCount = 0;
+    unmapFile(indexFile);
+}
+
+bool seedIndexLoaded() {
+    return entries != nullptr;
+}
+
+bool pickSeed(float lo, float hi, uint32_t& rng, uint32_t& seed) {
+    if (!entries) return false;
+    int low = (int)clamp(lo * SEED_DIFFICULTY_MAX + 0.5f, 0.0f, (float)SEED_DIFFICULTY_MAX);
+    int high = (int)clamp(hi * SEED_DIFFICULTY_MAX + 0.5f, 0.0f, (float)SEED_DIFFICULTY_MAX - 1);// không bao giờ chọn seed không qua được
+    const SeedEntry* end = entries + entryCount;
+    const SeedEntry* first = lower_bound(entries, end, low, [](const SeedEntry& e, int d) { return e.difficulty < d; });
+    const SeedEntry* last = upper_bound(first, end, high, [](int d, const SeedEntry& e) { return d < e.difficulty; });
+    if (first >= last) return false;
+    seed = first[simRandom(rng) % (uint32_t)(last - first)].seed;
+    return true;
+}
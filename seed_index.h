@@ -0,0 +1,48 @@
+#ifndef SEED_INDEX_H
+#define SEED_INDEX_H
+
+#include "sim.h"
+#include <cstdint>
+
+// Chỉ mục độ khó theo seed đường ống, do công cụ seed_rank tính sẵn (Monte Carlo), game chỉ mmap rồi tra.
+// File = SeedIndexHeader + count * SeedEntry, sắp tăng dần theo difficulty để chọn dải bằng tìm kiếm nhị phân.
+const int SEED_COURSE_PIPES = 30;       // độ dài đường ống được chấm (≈ 50 giây chơi)
+const int SEED_DIFFICULTY_MAX = 65535;  // seed mà bot tham chiếu cũng không qua hết
+
+// Phép thử va chạm dùng lúc chấm. Độ khó chấm bằng hitbox chữ nhật không đúng cho va chạm từng pixel,
+// nên game chỉ nhận chỉ mục chấm bằng hitbox chữ nhật và chơi các seed rút từ đó bằng chính hitbox này
+enum SeedHitbox : int16_t {
+    SEED_HITBOX_RECT,       // simHitsPipe, seed_rank chạy headless chỉ có phép này
+    SEED_HITBOX_PIXEL,      // mask từ ảnh chim/ống (pixel_mask.h)
+};
+
+struct SeedIndexHeader {
+    char magic[4];          // "FLSI"
+    uint16_t version;
+    int16_t gravity, jumpStrength, pipeGap, pipeSpeed, pipeWidth, pipeSpawnX, coursePipes;
+    int16_t hitbox;         // SeedHitbox
+    int16_t reserved;       // = 0, giữ rollouts thẳng hàng 4 byte
+    uint32_t rollouts;      // số ván bot trễ mỗi ống
+    uint32_t count;
+};
+static_assert(sizeof(SeedIndexHeader) == 32, "header không được có đệm");
+
+struct SeedEntry {
+    uint32_t seed;
+    uint16_t difficulty;    // 0 = mọi ván ngẫu nhiên đều qua hết, SEED_DIFFICULTY_MAX = không qua được
+    uint16_t referencePipes;// số ống bot tham chiếu qua được (tối đa SEED_COURSE_PIPES)
+};
+static_assert(sizeof(SeedEntry) == 8, "entry phải gọn 8 byte");
+
+SeedIndexHeader seedIndexExpectedHeader(SeedHitbox hitbox, uint32_t rollouts, uint32_t count);
+
+// mmap, từ chối nếu luật chơi trong header khác bản build hoặc chấm bằng phép thử va chạm khác hitbox
+bool loadSeedIndex(const char* path, SeedHitbox hitbox);
+void unloadSeedIndex();
+bool seedIndexLoaded();
+
+// Rút ngẫu nhiên 1 seed có difficulty trong [lo, hi] (thang 0..1, bỏ seed không qua được); false nếu chưa nạp hoặc dải rỗng.
+// Không cấp phát, O(log n), an toàn để gọi lúc bắt đầu ván trên luồng mô phỏng.
+bool pickSeed(float lo, float hi, uint32_t& rng, uint32_t& seed);
+
+#endif
@@ -0,0 +1,117 @@
+#include "seed_index.h"
+#include "autopilot.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Chấm độ khó từng seed bằng Monte Carlo rồi ghi chỉ mục cho seed_index.h.
+// Mỗi seed: 1 ván bot tham chiếu (autopilot) để loại seed không qua được, rồi các ván của bot "người":
+// vẫn là autopilot nhưng mỗi cú nhảy trễ ngẫu nhiên 0..MAX_LAG tick như phản xạ người.
+// Ống nào đòi nhảy càng đúng lúc thì bot trễ càng hay chết; difficulty = tỉ lệ chết trung bình mỗi ống.
+// Dùng: seed_rank [số seed] [ván mỗi ống] [file]
+const int MAX_LAG = 1;                  // trễ 2 tick thì ống nào cũng khó như nhau, thứ hạng thành nhiễu
+const int SEEDS_PER_TASK = 64;
+
+// Chơi từ trạng thái s tới khi qua thêm 1 ống; false nếu chết trước đó
+static bool clearsNextPipe(SimState s, uint32_t& rng) {
+    int target = s.score + 1;
+    int delay = -1;                     // số tick còn lại trước cú nhảy đang chờ
+    while (!s.gameOver && s.score < target) {
+        bool jump = false;
+        if (delay >= 0) {
+            jump = delay == 0;
+            delay--;
+        } else if (autopilotDecide(s)) {
+            delay = (int)(simRandom(rng) % (MAX_LAG + 1)) - 1;
+            jump = delay < 0;
+        }
+        simStep(s, jump);
+    }
+    return !s.gameOver;
+}
+
+// Bot tham chiếu chạy cả đường ống, giữ trạng thái lúc vừa qua mỗi ống làm điểm xuất phát cho các ván trễ.
+// Chấm từng ống riêng thay vì chơi lại từ đầu: ván nào cũng cho thông tin về đúng 1 ống nên phương sai thấp hơn nhiều.
+static SeedEntry rankSeed(uint32_t seed, int rollouts) {
+    SimState checkpoints[SEED_COURSE_PIPES];
+    SimState s;
+    simSeed(s, seed);
+    checkpoints[0] = s;
+    while (!s.gameOver && s.score < SEED_COURSE_PIPES) {
+        int passed = s.score;
+        simStep(s, autopilotDecide(s));
+        if (!s.gameOver && s.score > passed && s.score < SEED_COURSE_PIPES) checkpoints[s.score] = s;
+    }
+    SeedEntry entry = {seed, SEED_DIFFICULTY_MAX, (uint16_t)min(s.score, SEED_COURSE_PIPES)};
+    if (entry.referencePipes < SEED_COURSE_PIPES) return entry;
+
+    uint32_t rng = seed * 2654435761u;
+    int failed = 0;
+    for (int pipe = 0; pipe < SEED_COURSE_PIPES; pipe++)
+        for (int r = 0; r < rollouts; r++) failed += !clearsNextPipe(checkpoints[pipe], rng);
+    double difficulty = (double)failed / ((long long)rollouts * SEED_COURSE_PIPES);
+    entry.difficulty = (uint16_t)(difficulty * (SEED_DIFFICULTY_MAX - 1) + 0.5);// MAX dành cho seed không qua được
+    return entry;
+}
+
+int main(int argc, char* argv[]) {
+    int seedCount = argc > 1 ? atoi(argv[1]) : 16384;
+    int rollouts = argc > 2 ? atoi(argv[2]) : 64;
+    const char* path = argc > 3 ? argv[3] : "seed_index.bin";
+    if (seedCount <= 0 || rollouts <= 0) {
+        printf("usage: seed_rank [seeds] [rollouts per pipe] [output]\n");
+        return 1;
+    }
+    int threadCount = max(1, (int)thread::hardware_concurrency());
+    printf("%d seeds x %d pipes x %d rollouts + 1 reference game, %d threads\n", seedCount, SEED_COURSE_PIPES, rollouts,
+           threadCount);
+
+    // seed 0 bị simRandom đổi thành hằng, nên đánh từ 1
+    vector<SeedEntry> entries(seedCount);
+    atomic<int> next{0};
+    auto start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&] {
+            for (int task = next++; task * SEEDS_PER_TASK < seedCount; task = next++) {
+                int end = min(seedCount, (task + 1) * SEEDS_PER_TASK);
+                for (int i = task * SEEDS_PER_TASK; i < end; i++) entries[i] = rankSeed((uint32_t)i + 1, rollouts);
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    sort(entries.begin(), entries.end(), [](const SeedEntry& a, const SeedEntry& b) {
+        return a.difficulty != b.difficulty ? a.difficulty < b.difficulty : a.seed < b.seed;
+    });
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        printf("cannot write %s\n", path);
+        return 1;
+    }
+    SeedIndexHeader header = seedIndexExpectedHeader(SEED_HITBOX_RECT, rollouts, seedCount);// simStep() mặc định
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(entries.data(), sizeof(SeedEntry), seedCount, file) == (size_t)seedCount;
+    ok &= fclose(file) == 0;
+    if (!ok) {
+        printf("cannot write %s\n", path);
+        return 1;
+    }
+
+    int unbeatable = 0;
+    for (const SeedEntry& entry : entries) unbeatable += entry.difficulty == SEED_DIFFICULTY_MAX;
+    printf("%.1f s, %.0f seeds/s, %d unbeatable for the reference bot\n", seconds, seedCount / seconds, unbeatable);
+    printf("difficulty percentiles:");
+    for (int p = 0; p <= 100; p += 10) {
+        int i = min(seedCount - 1, seedCount * p / 100);
+        printf(" p%d=%.3f", p, (double)entries[i].difficulty / SEED_DIFFICULTY_MAX);
+    }
+    printf("\nwrote %s\n", path);
+    return 0;
+}
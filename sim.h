@@ -0,0 +1,232 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <cstdint>
+
+// Luật vật lý của game, không phụ thuộc SDL để dùng chung cho game, bot và công cụ chạy headless
+const int SCREEN_WIDTH = 800;
+const int SCREEN_HEIGHT = 600;
+const int GRAVITY = 1;
+const int JUMP_STRENGTH = -15;
+const int PIPE_WIDTH = 80;
+const int PIPE_GAP = 200;
+const int PIPE_SPEED = 3;
+const int GROUND_HEIGHT = 100;
+const int MAX_PIPES = 8;        // số ống tối đa cùng lúc trên màn hình
+const int PIPE_SPAWN_X = SCREEN_WIDTH - 300;// ống cuối qua mốc này thì sinh ống mới
+const int PIPE_MIN_HEIGHT = 100;
+const int PIPE_HEIGHT_RANGE = SCREEN_HEIGHT - GROUND_HEIGHT - PIPE_GAP - 200;
+
+const int BIRD_X = 100;
+const int BIRD_SIZE = 70;
+const int COLLISION_OFFSET = 15;// hitbox nhỏ hơn hình chim mỗi cạnh
+
+struct Pipe {
+    int x, height;
+    bool scored = false;
+    int16_t gap = PIPE_GAP;     // đường ống sinh dần (course.h) đổi khe theo từng ống; luật cố định thì = pipeGap
+};
+
+enum SimEvents : uint8_t {
+    SIM_SCORED = 1,
+    SIM_HIT_GROUND = 2,
+    SIM_HIT_PIPE = 4,
+    SIM_HIT_CEILING = 8,        // bị chặn ở y < 0
+    SIM_PIPE_SPAWNED = 16,
+};
+
+// Toàn bộ trạng thái 1 ván, kích thước cố định để sao chép rẻ
+struct SimState {
+    int birdY = SCREEN_HEIGHT / 2;
+    int birdVelocity = 0;
+    Pipe pipes[MAX_PIPES];
+    int pipeCount = 0;
+    int score = 0;
+    bool gameOver = false;
+    uint32_t rng = 1;
+    uint32_t tick = 0;
+};
+
+// xorshift32, seed 0 bị kẹt nên đổi sang hằng khác
+inline uint32_t simRandom(uint32_t& rng) {
+    if (rng == 0) rng = 0x9E3779B9u;
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+inline void simSeed(SimState& s, uint32_t seed) {
+    s = SimState();
+    s.rng = seed;
+}
+
+// Về vị trí ban đầu, giữ nguyên rng để ván sau có đường ống khác
+inline void simReset(SimState& s) {
+    uint32_t rng = s.rng;
+    s = SimState();
+    s.rng = rng;
+}
+
+// Luật đổi được giữa các chế độ chơi. Mỗi hàm luật nhận SimRules; bản template (tham số template kiểu struct
+// của C++20) truyền vào 1 hằng nên sau khi inline mọi hằng số đã gập, còn công cụ quét tham số thì truyền luật lúc chạy.
+struct SimRules {
+    int gravity;
+    int jumpStrength;
+    int pipeGap;
+    int pipeSpeed;
+    int pipeWidth;
+    int groundHeight;
+    int pipeSpawnX;             // ống cuối qua mốc này thì sinh ống mới (khoảng cách ống = SCREEN_WIDTH - pipeSpawnX)
+
+    constexpr int groundY() const { return SCREEN_HEIGHT - groundHeight; }
+    constexpr int pipeHeightRange() const { return SCREEN_HEIGHT - groundHeight - pipeGap - 200; }
+};
+
+constexpr SimRules CLASSIC_RULES = {GRAVITY, JUMP_STRENGTH, PIPE_GAP, PIPE_SPEED, PIPE_WIDTH, GROUND_HEIGHT, PIPE_SPAWN_X};
+
+// Phần chim của 1 tick: nhảy, trọng lực, trần, đất
+inline int simStepBirdRules(const SimRules& r, int& y, int& velocity, bool jump) {
+    int events = 0;
+    if (jump) velocity = r.jumpStrength;
+
+    velocity += r.gravity;
+    y += velocity;
+    if (y < 0) {
+        y = 0;
+        velocity = 0;
+        events |= SIM_HIT_CEILING;
+    }
+    if (y + BIRD_SIZE >= r.groundY()) events |= SIM_HIT_GROUND;
+    return events;
+}
+
+// Dịch ống sang trái, bỏ ống đã ra khỏi màn hình
+inline void simShiftPipesRules(const SimRules& r, SimState& s) {
+    for (int i = 0; i < s.pipeCount; i++) s.pipes[i].x -= r.pipeSpeed;
+    if (s.pipeCount > 0 && s.pipes[0].x < -r.pipeWidth) {
+        for (int i = 1; i < s.pipeCount; i++) s.pipes[i - 1] = s.pipes[i];
+        s.pipeCount--;
+    }
+}
+
+// Phần ống: dịch, bỏ ống cũ, sinh ống mới từ rng (đường ống sinh dần thì tự sinh, xem course.cpp)
+inline int simStepPipesRules(const SimRules& r, SimState& s) {
+    simShiftPipesRules(r, s);
+    if ((s.pipeCount == 0 || s.pipes[s.pipeCount - 1].x < r.pipeSpawnX) && s.pipeCount < MAX_PIPES) {
+        int height = (int)(simRandom(s.rng) % r.pipeHeightRange()) + PIPE_MIN_HEIGHT;
+        s.pipes[s.pipeCount++] = {SCREEN_WIDTH, height, false, (int16_t)r.pipeGap};
+        return SIM_PIPE_SPAWNED;
+    }
+    return 0;
+}
+
+// Hitbox chim ở độ cao y có chạm ống nào không; khe lấy theo từng ống
+inline bool simHitsPipeRules(const SimRules& r, const SimState& s, int y) {
+    const int hitLeft = BIRD_X + COLLISION_OFFSET;
+    const int hitRight = BIRD_X + BIRD_SIZE - COLLISION_OFFSET;
+    for (int i = 0; i < s.pipeCount; i++) {
+        const Pipe& pipe = s.pipes[i];
+        if (hitRight > pipe.x && hitLeft < pipe.x + r.pipeWidth) {
+            if (y + COLLISION_OFFSET < pipe.height || y + BIRD_SIZE - COLLISION_OFFSET > pipe.height + pipe.gap) return true;
+        }
+    }
+    return false;
+}
+
+// Tính điểm cho các ống chim vừa vượt qua
+inline int simScorePipesRules(const SimRules& r, SimState& s) {
+    int events = 0;
+    for (int i = 0; i < s.pipeCount; i++) {
+        Pipe& pipe = s.pipes[i];
+        if (BIRD_X > pipe.x + r.pipeWidth && !pipe.scored) {
+            pipe.scored = true;
+            s.score++;
+            events |= SIM_SCORED;
+        }
+    }
+    return events;
+}
+
+// Thân simStepRules() dài nên GCC tự quyết thì không inline; ép inline vào vòng lặp gọi nó nhanh hơn ~15-40%
+// cho cả bản template lẫn bản SimRules lúc chạy (variant_bench). Gập hằng số của R thì gần như không thêm gì (0.95-1.07x).
+#if defined(__GNUC__)
+#define SIM_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define SIM_ALWAYS_INLINE inline
+#endif
+
+// Phép thử chim-ống thay được, mặc định (nullptr) là hitbox chữ nhật ở trên
+typedef bool (*SimPipeTest)(const SimState& s, int y);
+
+// 1 tick vật lý, giống hệt update() cũ; trả về các cờ SimEvents
+SIM_ALWAYS_INLINE int simStepRules(const SimRules& r, SimState& s, bool jump, SimPipeTest hitsPipe = nullptr) {
+    int events = simStepBirdRules(r, s.birdY, s.birdVelocity, jump);
+    events |= simStepPipesRules(r, s);
+    events |= simScorePipesRules(r, s);
+    if (hitsPipe ? hitsPipe(s, s.birdY) : simHitsPipeRules(r, s, s.birdY)) events |= SIM_HIT_PIPE;
+    if (events & (SIM_HIT_GROUND | SIM_HIT_PIPE)) s.gameOver = true;
+    s.tick++;
+    return events;
+}
+
+// Bản hằng số gập lúc biên dịch, mặc định luật gốc
+template <SimRules R = CLASSIC_RULES>
+inline int simStepBird(int& y, int& velocity, bool jump) {
+    return simStepBirdRules(R, y, velocity, jump);
+}
+
+template <SimRules R = CLASSIC_RULES>
+inline int simStepPipes(SimState& s) {
+    return simStepPipesRules(R, s);
+}
+
+template <SimRules R = CLASSIC_RULES>
+inline bool simHitsPipe(const SimState& s, int y) {
+    return simHitsPipeRules(R, s, y);
+}
+
+template <SimRules R = CLASSIC_RULES>
+inline int simScorePipes(SimState& s) {
+    return simScorePipesRules(R, s);
+}
+
+template <SimRules R = CLASSIC_RULES>
+inline int simStep(SimState& s, bool jump, SimPipeTest hitsPipe = nullptr) {
+    return simStepRules(R, s, jump, hitsPipe);
+}
+
+// Các biến thể dựng sẵn: chế độ dễ/khó và bài tập cho huấn luyện
+enum SimVariant : uint8_t {
+    SIM_CLASSIC,
+    SIM_EASY,               // khe rộng, ống chậm
+    SIM_HARD,               // khe hẹp, ống nhanh và dày hơn
+    SIM_FAST,               // ống rất nhanh, luyện phản xạ
+    SIM_VARIANT_COUNT,
+};
+
+constexpr SimRules SIM_VARIANT_RULES[SIM_VARIANT_COUNT] = {
+    CLASSIC_RULES,
+    {1, -14, 260, 2, 70, GROUND_HEIGHT, PIPE_SPAWN_X},
+    {1, -15, 170, 4, 90, GROUND_HEIGHT, PIPE_SPAWN_X + 40},
+    {1, -15, 220, 5, 80, GROUND_HEIGHT, PIPE_SPAWN_X},
+};
+
+inline const char* simVariantName(SimVariant variant) {
+    static const char* names[SIM_VARIANT_COUNT] = {"classic", "easy", "hard", "fast"};
+    return variant < SIM_VARIANT_COUNT ? names[variant] : "classic";
+}
+
+// Chọn biến thể 1 lần bên ngoài vòng lặp nóng: gọi body.template operator()<R>() với R = luật của biến thể,
+// ví dụ simDispatch(v, [&]<SimRules R>() { while (...) simStep<R>(s, jump); });
+template <typename Body>
+inline decltype(auto) simDispatch(SimVariant variant, Body&& body) {
+    switch (variant) {
+        case SIM_EASY: return body.template operator()<SIM_VARIANT_RULES[SIM_EASY]>();
+        case SIM_HARD: return body.template operator()<SIM_VARIANT_RULES[SIM_HARD]>();
+        case SIM_FAST: return body.template operator()<SIM_VARIANT_RULES[SIM_FAST]>();
+        default: return body.template operator()<CLASSIC_RULES>();
+    }
+}
+
+#endif
@@ -0,0 +1,150 @@
+#include "sim_advance.h"
+#include <algorithm>
+#include <cmath>
+using namespace std;
+
+const int HIT_LEFT = BIRD_X + COLLISION_OFFSET;
+const int HIT_RIGHT = BIRD_X + BIRD_SIZE - COLLISION_OFFSET;
+const int NEVER = 1 << 30;
+
+static int floorDiv(int a, int b) {
+    return a / b - (a % b != 0 && (a < 0) != (b < 0));
+}
+
+// y sau t tick không chạm trần: vận tốc cộng trọng lực trước rồi mới cộng vào y
+static long long birdYAt(const SimRules& r, int y0, int v0, int t) {
+    return y0 + (long long)t * v0 + (long long)r.gravity * t * (t + 1) / 2;
+}
+
+// Nghiệm thực của y(t) = c: g/2 t^2 + (v0 + g/2) t + y0 - c = 0; larger chọn nghiệm lớn.
+// Chỉ dùng làm điểm xuất phát, bên gọi sửa lại bằng phép so nguyên nên sai số double không ảnh hưởng.
+static double rootAt(const SimRules& r, int y0, int v0, long long c, bool larger) {
+    double a = r.gravity * 0.5, b = v0 + r.gravity * 0.5;
+    double disc = max(b * b - 4 * a * (y0 - c), 0.0);
+    return (-b + (larger ? sqrt(disc) : -sqrt(disc))) / (2 * a);
+}
+
+// Tick đầu tiên t trong [lo, hi] có y(t) > c, NEVER nếu không có.
+// y lồi nên khi y(lo) <= c thì tập y > c phía sau lo là [nghiệm lớn, vô cùng).
+static int firstAbove(const SimRules& r, int y0, int v0, long long c, int lo, int hi) {
+    if (lo > hi) return NEVER;
+    if (birdYAt(r, y0, v0, lo) > c) return lo;
+    if (birdYAt(r, y0, v0, hi) <= c) return NEVER;
+    int t = clamp((int)floor(rootAt(r, y0, v0, c, true)) + 1, lo + 1, hi);
+    while (t > lo + 1 && birdYAt(r, y0, v0, t - 1) > c) t--;
+    while (birdYAt(r, y0, v0, t) <= c) t++;
+    return t;
+}
+
+// Tick đầu tiên t trong [lo, hi] có y(t) < c, NEVER nếu không có.
+// Tập y < c là khoảng giữa 2 nghiệm; khi y(lo) >= c thì chỉ có thể là nghiệm nhỏ, trên nhánh đi xuống.
+static int firstBelow(const SimRules& r, int y0, int v0, long long c, int lo, int hi) {
+    if (lo > hi) return NEVER;
+    if (birdYAt(r, y0, v0, lo) < c) return lo;
+    // y(t + 1) - y(t) = v0 + g(t + 1) >= 0 từ đáy trở đi
+    int bottom = clamp(-floorDiv(v0, r.gravity) - 1, lo, hi);
+    if (birdYAt(r, y0, v0, bottom) >= c) return NEVER;
+    int t = clamp((int)floor(rootAt(r, y0, v0, c, false)) + 1, lo + 1, bottom);
+    while (t > lo + 1 && birdYAt(r, y0, v0, t - 1) < c) t--;
+    while (birdYAt(r, y0, v0, t) >= c) t++;
+    return t;
+}
+
+// Tick đầu tiên (>= 1) có sự kiện rời rạc: ống bị bỏ, ống mới sinh, chim chạm trần
+static int nextBoundary(const SimRules& r, const SimState& s, int v0) {
+    int boundary = firstBelow(r, s.birdY, v0, 0, 1, NEVER - 1);
+    if (s.pipeCount == 0) return 1;
+    boundary = min(boundary, floorDiv(s.pipes[0].x + r.pipeWidth, r.pipeSpeed) + 1);
+    if (s.pipeCount < MAX_PIPES) boundary = min(boundary, floorDiv(s.pipes[s.pipeCount - 1].x - r.pipeSpawnX, r.pipeSpeed) + 1);
+    return max(boundary, 1);
+}
+
+// Tick ống được tính điểm: BIRD_X > x - pipeSpeed * t + pipeWidth
+static int scoreTick(const SimRules& r, const Pipe& p) {
+    return p.scored ? NEVER : max(1, floorDiv(p.x + r.pipeWidth - BIRD_X, r.pipeSpeed) + 1);
+}
+
+// Va chạm trong [1, ticks] với tập ống cố định; ground/pipe = tick chạm đất/ống (NEVER nếu không)
+static void sweep(const SimRules& r, const SimState& s, int v0, int ticks, int& ground, int& pipe) {
+    ground = firstAbove(r, s.birdY, v0, r.groundY() - BIRD_SIZE - 1, 1, ticks);// y + BIRD_SIZE >= groundY là chạm đất
+    pipe = NEVER;
+    for (int i = 0; i < s.pipeCount; i++) {
+        const Pipe& p = s.pipes[i];
+        // x(t) = x - pipeSpeed * t chồng lên hitbox khi x(t) < HIT_RIGHT và x(t) + pipeWidth > HIT_LEFT
+        int enter = max(1, floorDiv(p.x - HIT_RIGHT, r.pipeSpeed) + 1);
+        int exit = min(min(ticks, pipe - 1), -floorDiv(-(p.x + r.pipeWidth - HIT_LEFT), r.pipeSpeed) - 1);
+        if (enter > exit) continue;
+        pipe = min(pipe, firstBelow(r, s.birdY, v0, p.height - COLLISION_OFFSET, enter, exit));
+        pipe = min(pipe, firstAbove(r, s.birdY, v0, p.height + p.gap - BIRD_SIZE + COLLISION_OFFSET, enter, exit));
+    }
+}
+
+// Chạy n tick theo công thức (không có mốc rời rạc bên trong); ground/pipe = kết quả sweep() để đánh dấu tick n
+static int coast(const SimRules& r, SimState& s, int v0, int n, int ground, int pipe) {
+    int events = 0;
+    s.birdY = (int)birdYAt(r, s.birdY, v0, n);
+    s.birdVelocity = v0 + r.gravity * n;
+    for (int i = 0; i < s.pipeCount; i++) {
+        Pipe& p = s.pipes[i];
+        if (scoreTick(r, p) <= n) {
+            p.scored = true;
+            s.score++;
+            events |= SIM_SCORED;
+        }
+        p.x -= r.pipeSpeed * n;
+    }
+    s.tick += n;
+    if (ground == n) events |= SIM_HIT_GROUND;
+    if (pipe == n) events |= SIM_HIT_PIPE;
+    if (ground == n || pipe == n) s.gameOver = true;
+    return events;
+}
+
+int simTimeOfImpactRules(const SimRules& r, const SimState& s, bool jump, int ticks) {
+    int ground, pipe;
+    sweep(r, s, jump ? r.jumpStrength : s.birdVelocity, ticks, ground, pipe);
+    return min(min(ground, pipe), ticks + 1);
+}
+
+int simAdvanceRules(const SimRules& r, SimState& s, bool jump, int ticks) {
+    int events = 0;
+    while (ticks > 0 && !s.gameOver) {
+        if (ticks == 1) return events | simStepRules(r, s, jump);// 1 tick thì quét không lợi gì
+        int v0 = jump ? r.jumpStrength : s.birdVelocity;
+        int quiet = min(ticks, nextBoundary(r, s, v0) - 1);
+        if (quiet <= 0) {
+            events |= simStepRules(r, s, jump);// tick mốc: chạy đúng luật từng bước
+            jump = false;
+            ticks--;
+            continue;
+        }
+
+        int ground, pipe;
+        sweep(r, s, v0, quiet, ground, pipe);
+        int n = min(quiet, min(ground, pipe));
+        events |= coast(r, s, v0, n, ground, pipe);
+        ticks -= n;
+        jump = false;
+    }
+    return events;
+}
+
+int simSkipRules(const SimRules& r, SimState& s, int ticks) {
+    while (ticks > 0 && !s.gameOver) {
+        int quiet = min(ticks, nextBoundary(r, s, s.birdVelocity) - 1);
+        if (quiet <= 0) {
+            ticks--;
+            if (int events = simStepRules(r, s, false)) return events;// tick mốc có sự kiện (sinh ống, chạm trần...) thì dừng
+            continue;// chỉ bỏ ống ra khỏi màn hình: đi tiếp
+        }
+
+        int stop = quiet;
+        for (int i = 0; i < s.pipeCount; i++) stop = min(stop, scoreTick(r, s.pipes[i]));
+        int ground, pipe;
+        sweep(r, s, s.birdVelocity, stop, ground, pipe);
+        int n = min(stop, min(ground, pipe));
+        ticks -= n;
+        if (int events = coast(r, s, s.birdVelocity, n, ground, pipe)) return events;
+    }
+    return 0;
+}
@@ -0,0 +1,39 @@
+#ifndef SIM_ADVANCE_H
+#define SIM_ADVANCE_H
+
+#include "sim.h"
+
+// Bước nhiều tick 1 lần cho chế độ headless tua nhanh.
+// Giữa 2 mốc rời rạc (sinh/bỏ ống, chạm trần) chim bay theo parabol và ống trôi đều, nên va chạm quét:
+// với mỗi ống tính khoảng tick chồng theo x, rồi tìm tick đầu tiên y rơi ra ngoài khe bằng nghiệm
+// phương trình bậc 2 (sửa lại bằng phép so nguyên), O(1) mỗi đoạn.
+// Tick mốc chạy bằng simStepRules() để giữ đúng thứ tự luật; kết quả giống hệt gọi simStepRules() từng tick.
+// Chỉ cho hitbox chữ nhật của simHitsPipeRules() và luật có gravity > 0 (mọi SIM_VARIANT_RULES).
+// Không dùng cho trạng thái chế độ đường ống (course.h): ở đó ống sinh từ luồng chứ không từ s.rng,
+// tick mốc sinh ống ở đây sẽ sinh sai ống.
+
+// Chạy tối đa ticks tick, chỉ nhảy ở tick đầu; dừng đúng ở tick va chạm (gameOver).
+// Trả về các cờ SimEvents gộp của mọi tick đã chạy.
+int simAdvanceRules(const SimRules& r, SimState& s, bool jump, int ticks);
+
+// Tua tối đa ticks tick không nhảy, dừng ngay sau tick đầu tiên có sự kiện (va chạm, ghi điểm, sinh ống, chạm trần).
+// Trả về cờ SimEvents của tick dừng, 0 nếu chạy đủ ticks mà không có gì. Số đoạn phải tính không phụ thuộc ticks.
+int simSkipRules(const SimRules& r, SimState& s, int ticks);
+
+// Tick va chạm đầu tiên trong [1, ticks] nếu không nhảy lại và không có ống mới; ticks + 1 nếu không chạm
+int simTimeOfImpactRules(const SimRules& r, const SimState& s, bool jump, int ticks);
+
+// Luật gốc
+inline int simAdvance(SimState& s, bool jump, int ticks) {
+    return simAdvanceRules(CLASSIC_RULES, s, jump, ticks);
+}
+
+inline int simSkip(SimState& s, int ticks) {
+    return simSkipRules(CLASSIC_RULES, s, ticks);
+}
+
+inline int simTimeOfImpact(const SimState& s, bool jump, int ticks) {
+    return simTimeOfImpactRules(CLASSIC_RULES, s, jump, ticks);
+}
+
+#endif
@@ -0,0 +1,35 @@
+#include "sprite_batch.h"
+
+void initSpriteBatch(SpriteBatch& batch, int capacity) {
+    batch.capacity = capacity;
+    batch.sprites = 0;
+    batch.vertices.resize(capacity * 4);
+    batch.indices.resize(capacity * 6);
+    for (int i = 0; i < capacity; i++) {
+        int v = i * 4;
+        int* index = &batch.indices[i * 6];
+        index[0] = v;
+        index[1] = v + 1;
+        index[2] = v + 2;
+        index[3] = v + 2;
+        index[4] = v + 3;
+        index[5] = v;
+    }
+}
+
+void batchSprite(SpriteBatch& batch, float x, float y, float w, float h, SDL_Color color) {
+    if (batch.sprites == batch.capacity) return;
+    SDL_Vertex* v = &batch.vertices[batch.sprites * 4];
+    v[0] = {{x, y}, color, {0, 0}};
+    v[1] = {{x + w, y}, color, {1, 0}};
+    v[2] = {{x + w, y + h}, color, {1, 1}};
+    v[3] = {{x, y + h}, color, {0, 1}};
+    batch.sprites++;
+}
+
+int flushSprites(SDL_Renderer* renderer, SDL_Texture* texture, SpriteBatch& batch) {
+    if (batch.sprites == 0) return 0;
+    SDL_RenderGeometry(renderer, texture, batch.vertices.data(), batch.sprites * 4, batch.indices.data(), batch.sprites * 6);
+    batch.sprites = 0;
+    return 1;
+}
@@ -0,0 +1,20 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Nhiều bản của cùng 1 texture, mỗi bản màu/alpha riêng qua màu đỉnh, vẽ bằng 1 lần SDL_RenderGeometry.
+// Chỉ số tam giác dựng sẵn 1 lần lúc khởi tạo, mỗi khung chỉ ghi đỉnh.
+struct SpriteBatch {
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    int sprites = 0;
+    int capacity = 0;
+};
+
+void initSpriteBatch(SpriteBatch& batch, int capacity);
+void batchSprite(SpriteBatch& batch, float x, float y, float w, float h, SDL_Color color);// đầy thì bỏ qua
+int flushSprites(SDL_Renderer* renderer, SDL_Texture* texture, SpriteBatch& batch);
+
+#endif
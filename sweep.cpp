@@ -0,0 +1,210 @@
+#include "autopilot.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Quét tham số độ khó headless: mỗi điểm (khe, tốc độ ống, trọng lực, khoảng cách ống) cho autopilot chơi
+// nhiều ván với cùng bộ seed, song song trên mọi lõi, rồi ghi 1 dòng TSV: phân bố điểm và đường sống sót.
+// Autopilot gần như không chết nên bảng chỉ phân biệt được điểm rất khó; --noise N lật 1/N quyết định (như rewind_bench)
+// để điểm số trải ra theo độ khó. Trễ phản xạ thì không dùng được: autopilot nhảy sát nút, trễ 1 tick là chết ngay.
+// Dùng: sweep [--games N] [--ticks N] [--random N] [--seed N] [--noise N] [--out file] [gap=lo:hi:step] [speed=..] [gravity=..] [spacing=..]
+const int SURVIVAL_STEP = 600;          // 1 mốc sống sót mỗi 10 giây chơi
+const int MAX_SURVIVAL_POINTS = 64;
+
+enum SweepParam { PARAM_GAP, PARAM_SPEED, PARAM_GRAVITY, PARAM_SPACING, PARAM_COUNT };
+
+struct SweepRange {
+    const char* name;
+    int lo, hi, step;
+
+    int count() const { return (hi - lo) / step + 1; }
+};
+
+struct SweepPoint {
+    int value[PARAM_COUNT];
+};
+
+struct SweepResult {
+    double meanScore;
+    int p10, p50, p90, maxScore;
+    int alive[MAX_SURVIVAL_POINTS];     // số ván còn sống ở mỗi mốc SURVIVAL_STEP
+};
+
+static SimRules pointRules(const SweepPoint& point) {
+    SimRules r = CLASSIC_RULES;
+    r.pipeGap = point.value[PARAM_GAP];
+    r.pipeSpeed = point.value[PARAM_SPEED];
+    r.gravity = point.value[PARAM_GRAVITY];
+    r.pipeSpawnX = SCREEN_WIDTH - point.value[PARAM_SPACING];
+    return r;
+}
+
+// name=lo:hi:step hoặc name=value
+static bool parseRange(const char* arg, SweepRange* ranges) {
+    for (int p = 0; p < PARAM_COUNT; p++) {
+        size_t length = strlen(ranges[p].name);
+        if (strncmp(arg, ranges[p].name, length) != 0 || arg[length] != '=') continue;
+        SweepRange& range = ranges[p];
+        int fields = sscanf(arg + length + 1, "%d:%d:%d", &range.lo, &range.hi, &range.step);
+        if (fields == 1) range.hi = range.lo;
+        if (fields < 3) range.step = 1;
+        return fields >= 1 && range.step > 0 && range.hi >= range.lo;
+    }
+    return false;
+}
+
+// Ván chơi theo luật của điểm; điểm cùng bộ seed nên khác biệt giữa các điểm chỉ do luật
+// noise > 0: lật 1/noise quyết định của autopilot
+static void evaluate(const SweepPoint& point, int noise, int games, int ticks, uint32_t firstSeed, int* scores,
+                     SweepResult& result, long long& tickCount) {
+    SimRules r = pointRules(point);
+    int curvePoints = ticks / SURVIVAL_STEP;
+    memset(&result, 0, sizeof(result));
+    long long total = 0;
+    for (int g = 0; g < games; g++) {
+        SimState s;
+        simSeed(s, firstSeed + 7919u * g);
+        uint32_t noiseRng = (firstSeed + 7919u * g) * 2654435761u | 1;// cùng nhiễu ở mọi điểm, như seed
+        while (!s.gameOver && (int)s.tick < ticks) {
+            bool jump = autopilotDecideRules(r, s);
+            if (noise > 0 && simRandom(noiseRng) % noise == 0) jump = !jump;
+            simStepRules(r, s, jump);
+        }
+        tickCount += s.tick;
+        scores[g] = s.score;
+        total += s.score;
+        int survived = s.gameOver ? (int)s.tick : ticks;// chết ở tick cuối vẫn tính là chưa sống hết mốc đó
+        for (int c = 0; c < curvePoints && (c + 1) * SURVIVAL_STEP <= survived; c++) result.alive[c]++;
+    }
+    result.meanScore = (double)total / games;
+    sort(scores, scores + games);
+    result.p10 = scores[games / 10];
+    result.p50 = scores[games / 2];
+    result.p90 = scores[games * 9 / 10];
+    result.maxScore = scores[games - 1];
+}
+
+int main(int argc, char* argv[]) {
+    SweepRange ranges[PARAM_COUNT] = {
+        {"gap", 140, 296, 8},           // khe tối đa 296: pipeHeightRange() phải > 0
+        {"speed", 2, 6, 1},
+        {"gravity", 1, 2, 1},
+        {"spacing", 200, 440, 5},
+    };
+    int games = 1000;
+    int ticks = 3600;
+    int randomPoints = 0;
+    uint32_t seed = 12345;
+    int noise = 0;
+    const char* path = "sweep.tsv";
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--games") && hasValue) games = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--ticks") && hasValue) ticks = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--random") && hasValue) randomPoints = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && hasValue) seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--noise") && hasValue) noise = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--out") && hasValue) path = argv[++i];
+        else if (!parseRange(argv[i], ranges)) {
+            printf("bad argument %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (games <= 0 || noise < 0 || ticks < SURVIVAL_STEP || ticks / SURVIVAL_STEP > MAX_SURVIVAL_POINTS) {
+        printf("need --games > 0, --noise >= 0 and %d <= --ticks <= %d\n", SURVIVAL_STEP, SURVIVAL_STEP * MAX_SURVIVAL_POINTS);
+        return 1;
+    }
+    SweepRange& gap = ranges[PARAM_GAP];
+    SweepRange& spacing = ranges[PARAM_SPACING];
+    if (ranges[PARAM_SPEED].lo <= 0 || ranges[PARAM_GRAVITY].lo <= 0 || gap.lo <= 0 || spacing.lo <= 0 ||
+        SimRules{1, JUMP_STRENGTH, gap.hi, 1, PIPE_WIDTH, GROUND_HEIGHT, 0}.pipeHeightRange() <= 0 || spacing.hi > SCREEN_WIDTH ||
+        (SCREEN_WIDTH + PIPE_WIDTH) / spacing.lo + 1 > MAX_PIPES) {
+        printf("ranges out of bounds: gap < %d, spacing in [%d, %d], speed and gravity > 0\n",
+               SCREEN_HEIGHT - GROUND_HEIGHT - 200, (SCREEN_WIDTH + PIPE_WIDTH) / (MAX_PIPES - 1) + 1, SCREEN_WIDTH);
+        return 1;
+    }
+
+    // lưới đầy đủ, hoặc randomPoints điểm rút ngẫu nhiên trên các nấc của lưới
+    vector<SweepPoint> points;
+    if (randomPoints > 0) {
+        uint32_t rng = seed;
+        points.resize(randomPoints);
+        for (SweepPoint& point : points)
+            for (int p = 0; p < PARAM_COUNT; p++)
+                point.value[p] = ranges[p].lo + (int)(simRandom(rng) % ranges[p].count()) * ranges[p].step;
+    } else {
+        SweepPoint point;
+        for (point.value[PARAM_GAP] = gap.lo; point.value[PARAM_GAP] <= gap.hi; point.value[PARAM_GAP] += gap.step)
+            for (point.value[PARAM_SPEED] = ranges[PARAM_SPEED].lo; point.value[PARAM_SPEED] <= ranges[PARAM_SPEED].hi;
+                 point.value[PARAM_SPEED] += ranges[PARAM_SPEED].step)
+                for (point.value[PARAM_GRAVITY] = ranges[PARAM_GRAVITY].lo; point.value[PARAM_GRAVITY] <= ranges[PARAM_GRAVITY].hi;
+                     point.value[PARAM_GRAVITY] += ranges[PARAM_GRAVITY].step)
+                    for (point.value[PARAM_SPACING] = spacing.lo; point.value[PARAM_SPACING] <= spacing.hi;
+                         point.value[PARAM_SPACING] += spacing.step)
+                        points.push_back(point);
+    }
+
+    int pointCount = (int)points.size();
+    int threadCount = max(1, (int)thread::hardware_concurrency());
+    printf("%d points x %d games x %d ticks, noise %d, %d threads\n", pointCount, games, ticks, noise, threadCount);
+    fflush(stdout);
+
+    // mỗi luồng lấy điểm kế tiếp từ bộ đếm chung; điểm dễ chạy hết ticks nên lâu hơn điểm khó nhiều lần.
+    // Số tick đếm trong biến cục bộ, ghi vào tickCounts 1 lần lúc xong (các phần tử kề nhau chung dòng cache)
+    vector<SweepResult> results(pointCount);
+    vector<long long> tickCounts(threadCount, 0);
+    atomic<int> next{0};
+    atomic<int> done{0};
+    auto start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&, t] {
+            vector<int> scores(games);
+            long long localTicks = 0;
+            for (int i = next++; i < pointCount; i = next++) {
+                evaluate(points[i], noise, games, ticks, seed, scores.data(), results[i], localTicks);
+                int finished = ++done;
+                if (finished * 20 / pointCount != (finished - 1) * 20 / pointCount) {
+                    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                    printf("%5.1f%%  %.1f s\n", 100.0 * finished / pointCount, seconds);
+                    fflush(stdout);
+                }
+            }
+            tickCounts[t] = localTicks;
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    FILE* out = fopen(path, "w");
+    if (!out) {
+        printf("cannot write %s\n", path);
+        return 1;
+    }
+    int curvePoints = ticks / SURVIVAL_STEP;
+    fprintf(out, "gap\tspeed\tgravity\tspacing\tgames\tmean\tp10\tp50\tp90\tmax");
+    for (int c = 0; c < curvePoints; c++) fprintf(out, "\ts%d", (c + 1) * SURVIVAL_STEP);
+    fprintf(out, "\n");
+    for (int i = 0; i < pointCount; i++) {
+        const SweepPoint& point = points[i];
+        const SweepResult& result = results[i];
+        fprintf(out, "%d\t%d\t%d\t%d\t%d\t%.2f\t%d\t%d\t%d\t%d", point.value[PARAM_GAP], point.value[PARAM_SPEED],
+                point.value[PARAM_GRAVITY], point.value[PARAM_SPACING], games, result.meanScore, result.p10, result.p50, result.p90,
+                result.maxScore);
+        for (int c = 0; c < curvePoints; c++) fprintf(out, "\t%.3f", (double)result.alive[c] / games);
+        fprintf(out, "\n");
+    }
+    fclose(out);
+
+    long long totalTicks = 0;
+    for (long long t : tickCounts) totalTicks += t;
+    printf("%.1f s, %.0f games/s, %.1f Mticks/s, wrote %s\n", seconds, (double)pointCount * games / seconds, totalTicks / (seconds * 1e6),
+           path);
+    return 0;
+}
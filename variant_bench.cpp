@@ -0,0 +1,103 @@
+#include "sim.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+using namespace std;
+
+// Chạy mọi biến thể luật trong 1 binary: bản template (simDispatch chọn 1 lần mỗi lô ván, hằng số đã gập)
+// so với simStepRules() đọc SimRules lúc chạy. Kết quả 2 bản phải giống hệt.
+// Đo được: 2 bản ngang nhau trong sai số (0.95-1.07x); lợi thật là inline simStepRules() vào vòng lặp, xem sim.h.
+// Mỗi bản chạy 1 lần khởi động không đo, rồi lấy lần nhanh nhất trong REPEATS lần đo xen kẽ 2 bản.
+const int DEFAULT_GAMES = 2000;
+const int MAX_TICKS = 36000;
+const int REPEATS = 5;
+
+// Bot theo luật: nhảy khi tick sau hitbox sẽ xuống dưới đáy khe của ống kế tiếp
+template <SimRules R>
+static bool gapPolicy(const SimState& s) {
+    for (int i = 0; i < s.pipeCount; i++) {
+        const Pipe& pipe = s.pipes[i];
+        if (pipe.x + R.pipeWidth <= BIRD_X + COLLISION_OFFSET) continue;
+        int bottom = pipe.height + R.pipeGap - (BIRD_SIZE - COLLISION_OFFSET) - 6;
+        return s.birdY + s.birdVelocity + R.gravity > bottom;
+    }
+    return s.birdY > SCREEN_HEIGHT / 2;
+}
+
+// Bản tham số lúc chạy: luật đọc từ struct mỗi lần, như công cụ quét tham số
+static bool runtimePolicy(const SimRules& r, const SimState& s) {
+    for (int i = 0; i < s.pipeCount; i++) {
+        const Pipe& pipe = s.pipes[i];
+        if (pipe.x + r.pipeWidth <= BIRD_X + COLLISION_OFFSET) continue;
+        int bottom = pipe.height + r.pipeGap - (BIRD_SIZE - COLLISION_OFFSET) - 6;
+        return s.birdY + s.birdVelocity + r.gravity > bottom;
+    }
+    return s.birdY > SCREEN_HEIGHT / 2;
+}
+
+struct Result {
+    long long ticks = 0, score = 0, checksum = 0;
+    int survived = 0;
+};
+
+static void finish(Result& result, const SimState& s) {
+    result.ticks += s.tick;
+    result.score += s.score;
+    result.survived += !s.gameOver;
+    result.checksum = result.checksum * 31 + s.birdY * 7 + s.score;
+}
+
+static Result playTemplated(SimVariant variant, int games) {
+    return simDispatch(variant, [&]<SimRules R>() {
+        Result result;
+        for (int game = 0; game < games; game++) {
+            SimState s;
+            simSeed(s, 7000 + game);
+            while (!s.gameOver && (int)s.tick < MAX_TICKS) simStep<R>(s, gapPolicy<R>(s));
+            finish(result, s);
+        }
+        return result;
+    });
+}
+
+static Result playRuntime(const SimRules& rules, int games) {
+    Result result;
+    for (int game = 0; game < games; game++) {
+        SimState s;
+        simSeed(s, 7000 + game);
+        while (!s.gameOver && (int)s.tick < MAX_TICKS) simStepRules(rules, s, runtimePolicy(rules, s));
+        finish(result, s);
+    }
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    int games = argc > 1 ? atoi(argv[1]) : DEFAULT_GAMES;
+    if (games <= 0) games = DEFAULT_GAMES;
+
+    printf("%d games per variant, %d ticks max, best of %d\n", games, MAX_TICKS, REPEATS);
+    printf("%-8s %5s %6s %6s %9s %11s %16s %16s %8s %6s\n", "variant", "gap", "speed", "width", "survival", "mean score",
+           "template Mt/s", "runtime Mt/s", "speedup", "same");
+    for (int v = 0; v < SIM_VARIANT_COUNT; v++) {
+        SimVariant variant = (SimVariant)v;
+        const SimRules& rules = SIM_VARIANT_RULES[v];
+        Result templated = playTemplated(variant, games);
+        Result runtime = playRuntime(rules, games);
+        double templatedS = 1e30, runtimeS = 1e30;
+        for (int r = 0; r < REPEATS; r++) {
+            auto start = chrono::steady_clock::now();
+            playTemplated(variant, games);
+            templatedS = min(templatedS, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+            start = chrono::steady_clock::now();
+            playRuntime(rules, games);
+            runtimeS = min(runtimeS, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+        }
+
+        bool same = templated.ticks == runtime.ticks && templated.score == runtime.score && templated.checksum == runtime.checksum;
+        printf("%-8s %5d %6d %6d %8.1f%% %11.1f %16.1f %16.1f %7.2fx %6s\n", simVariantName(variant), rules.pipeGap,
+               rules.pipeSpeed, rules.pipeWidth, 100.0 * templated.survived / games, (double)templated.score / games,
+               templated.ticks / templatedS / 1e6, runtime.ticks / runtimeS / 1e6, runtimeS / templatedS, same ? "yes" : "NO");
+    }
+    return 0;
+}